@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    AnalyzerCaptureRing.h
+    Created: 18 Oct 2026 11:52:40pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ The audio the analyzers look at, captured once per block.
+
+ The audio thread writes the first two channels of the main bus,
+ interleaved, into one ring in a single pass (a mono bus is written to
+ both). Any number of readers then take left, right, mid or side views
+ from it, each at its own position, so another analysis channel costs
+ no audio thread time and no extra memory.
+
+ The writer never waits, and the frames of the block it's writing are
+ overwritten before writeCount says so. A reader therefore only trusts a
+ ring less one block: one that falls further behind skips to the oldest
+ frames that are safe, and drops a read the writer overtook while it
+ was copying.
+ */
+class AnalyzerCaptureRing
+{
+public:
+    enum class View
+    {
+        left,
+        right,
+        mid,    //(L + R) / 2
+        side    //(L - R) / 2
+    };
+
+    //where one reader has got to, in frames since the ring was made
+    struct Reader
+    {
+        juce::uint64 position = 0;
+        juce::uint64 droppedFrames = 0;
+    };
+
+    //over half a second at 192 kHz. allocated once, so readers never see the ring move
+    static constexpr int capacity = 1 << 17;
+
+    AnalyzerCaptureRing() : frames(2 * static_cast<size_t>(capacity), 0.f) {}
+
+    //the block size the host promised, for readers that want to go at its pace
+    void prepare(int samplesPerBlock) { blockSize.store(samplesPerBlock); }
+    int getBlockSize() const { return blockSize.load(); }
+
+    //audio thread. the analyzers work in float, so a double precision buffer is narrowed as it goes in
+    template<typename SampleType>
+    void update(const juce::AudioBuffer<SampleType>& buffer) noexcept
+    {
+        jassert(buffer.getNumChannels() > 0);
+
+        const auto* left = buffer.getReadPointer(0);
+        const auto* right = buffer.getReadPointer(juce::jmin(1, buffer.getNumChannels() - 1));
+        const auto numSamples = buffer.getNumSamples();
+
+        auto write = writeCount.load(std::memory_order_relaxed);
+
+        //readers only keep a block's margin, so a host block bigger than the promised one
+        //is published a promised block at a time. otherwise runs either side of the end of the ring
+        const auto runLength = getMarginFrames();
+
+        for (int start = 0; start < numSamples;)
+        {
+            auto index = static_cast<int>(write & mask);
+            auto numToCopy = juce::jmin(numSamples - start, capacity - index, runLength);
+            auto* dest = frames.data() + 2 * static_cast<size_t>(index);
+
+            for (int i = 0; i < numToCopy; ++i)
+            {
+                dest[2 * i] = static_cast<float>(left[start + i]);
+                dest[2 * i + 1] = static_cast<float>(right[start + i]);
+            }
+
+            write += static_cast<juce::uint64>(numToCopy);
+            start += numToCopy;
+
+            writeCount.store(write, std::memory_order_release);
+        }
+    }
+
+    //a reader that starts with the next block written
+    Reader makeReader() const noexcept { return { writeCount.load(std::memory_order_acquire), 0 }; }
+
+    //frames 'reader' hasn't read yet, up to what read() would still accept
+    int getNumAvailable(const Reader& reader) const noexcept
+    {
+        auto write = writeCount.load(std::memory_order_acquire);
+        return write > reader.position ? static_cast<int>(juce::jmin(write - reader.position, getReadableFrames())) : 0;
+    }
+
+    /*
+     reader side: moves 'reader' on so at most 'numFramesToKeep' frames are left unread,
+     for a reader that only wants the newest ones. returns how many frames it skipped
+     */
+    juce::uint64 skipToLatest(Reader& reader, int numFramesToKeep) const noexcept
+    {
+        auto write = writeCount.load(std::memory_order_acquire);
+        auto keep = juce::jmin(static_cast<juce::uint64>(juce::jmax(0, numFramesToKeep)), getReadableFrames());
+
+        if (write < reader.position || write - reader.position <= keep)
+            return 0;
+
+        auto skipped = write - keep - reader.position;
+        reader.position = write - keep;
+        return skipped;
+    }
+
+    /*
+     reader side: copies up to 'maxFrames' of the oldest unread frames of 'view' into 'dest'
+     and moves 'reader' past them. returns how many were copied
+     */
+    int read(Reader& reader, View view, float* dest, int maxFrames) const noexcept
+    {
+        auto write = writeCount.load(std::memory_order_acquire);
+        auto readable = getReadableFrames();
+
+        //a reader that came from another ring
+        if (write < reader.position)
+            reader.position = write;
+
+        if (write - reader.position > readable)
+        {
+            reader.droppedFrames += write - reader.position - readable;
+            reader.position = write - readable;
+        }
+
+        auto numFrames = static_cast<int>(juce::jmin(static_cast<juce::uint64>(maxFrames), write - reader.position));
+
+        for (int copied = 0; copied < numFrames;)
+        {
+            auto index = static_cast<int>((reader.position + static_cast<juce::uint64>(copied)) & mask);
+            auto numToCopy = juce::jmin(numFrames - copied, capacity - index);
+            copyView(view, frames.data() + 2 * static_cast<size_t>(index), dest + copied, numToCopy);
+            copied += numToCopy;
+        }
+
+        //the writer may have lapped us while we copied, and then the oldest frames are newer audio.
+        //the block it's in the middle of counts too, since writeCount doesn't include it yet
+        if (writeCount.load(std::memory_order_acquire) - reader.position > readable)
+            return 0;
+
+        reader.position += static_cast<juce::uint64>(numFrames);
+        return numFrames;
+    }
+private:
+    static constexpr juce::uint64 mask = static_cast<juce::uint64>(capacity - 1);
+
+    std::vector<float> frames;
+    std::atomic<juce::uint64> writeCount{ 0 };
+    std::atomic<int> blockSize{ 0 };
+
+    //the most the writer writes before it publishes. without a prepare(), half the ring
+    int getMarginFrames() const noexcept
+    {
+        auto size = blockSize.load();
+        return size > 0 ? juce::jmin(size, capacity / 2) : capacity / 2;
+    }
+
+    //a ring less the run the writer may be in the middle of
+    juce::uint64 getReadableFrames() const noexcept
+    {
+        return static_cast<juce::uint64>(capacity - getMarginFrames());
+    }
+
+    static void copyView(View view, const float* source, float* dest, int numFrames) noexcept
+    {
+        switch (view)
+        {
+            case View::left:
+                for (int i = 0; i < numFrames; ++i)
+                    dest[i] = source[2 * i];
+                break;
+            case View::right:
+                for (int i = 0; i < numFrames; ++i)
+                    dest[i] = source[2 * i + 1];
+                break;
+            case View::mid:
+                for (int i = 0; i < numFrames; ++i)
+                    dest[i] = 0.5f * (source[2 * i] + source[2 * i + 1]);
+                break;
+            case View::side:
+                for (int i = 0; i < numFrames; ++i)
+                    dest[i] = 0.5f * (source[2 * i] - source[2 * i + 1]);
+                break;
+        }
+    }
+};
@@ -0,0 +1,351 @@
+/*
+  ==============================================================================
+
+    BandOversampler.cpp
+    Created: 18 Oct 2026 8:03:17pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include "BandOversampler.h"
+
+template <typename SampleType>
+void BandOversampler<SampleType>::prepare(const juce::dsp::ProcessSpec& spec, int newNumBands)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(newNumBands > 0 && newNumBands <= maxNumBands);
+
+    sampleRate = spec.sampleRate;
+    numBands = juce::jlimit(1, maxNumBands, newNumBands);
+
+    //the edge moved with the rate, and there's no path to keep a band on yet
+    crossoversAboveEdge = 0;
+    for (int index = 0; index < numBands - 1; ++index)
+    {
+        setCrossoverFrequency(index, crossoverFrequencies[static_cast<size_t>(index)]);
+    }
+
+    auto maxLatency = 0;
+
+    for (int f = 0; f < maxFactorLog2; ++f)
+    {
+        for (int band = 0; band < numBands; ++band)
+        {
+            auto& oversampler = oversamplers[static_cast<size_t>(f)][static_cast<size_t>(band)];
+            oversampler = std::make_unique<Oversampling>(spec.numChannels,
+                                                         static_cast<size_t>(f + 1),
+                                                         Oversampling::filterHalfBandFIREquiripple,
+                                                         true,
+                                                         true);
+            oversampler->initProcessing(spec.maximumBlockSize);
+            maxLatency = juce::jmax(maxLatency, juce::roundToInt(oversampler->getLatencyInSamples()));
+        }
+    }
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        auto& delayLine = delays[static_cast<size_t>(band)];
+        delayLine.setMaximumDelayInSamples(maxLatency);
+        delayLine.prepare(spec);
+        delayLine.setDelay(static_cast<SampleType>(getLatencySamples()));
+
+        auto& keyDelay = keyDelays[static_cast<size_t>(band)];
+        keyDelay.setMaximumDelayInSamples(maxLatency / 2);
+        keyDelay.prepare(spec);
+        keyDelay.setDelay(static_cast<SampleType>(getUpsamplingLatency()));
+
+        keyBuffers[static_cast<size_t>(band)].setSize(static_cast<int>(spec.numChannels),
+                                                      static_cast<int>(spec.maximumBlockSize) << maxFactorLog2);
+    }
+
+    reset();
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::reset()
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        for (auto& perFactor : oversamplers)
+        {
+            perFactor[static_cast<size_t>(band)]->reset();
+        }
+
+        delays[static_cast<size_t>(band)].reset();
+        keyDelays[static_cast<size_t>(band)].reset();
+    }
+
+    pathsStarted = false;
+    heardUpsampled = movingBands = fadingBands = 0;
+    upsampledBands = delayedBands = 0;
+    enteringUpsampled = enteringDelayed = 0;
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::setFactorLog2(int newFactorLog2)
+{
+    jassert(newFactorLog2 >= 0 && newFactorLog2 <= maxFactorLog2);
+    factorLog2 = juce::jlimit(0, maxFactorLog2, newFactorLog2);
+
+    //what the paths held was at the old factor's latency. a move in progress is dropped, every
+    //band starts over on the path it's heard from, and with oversampling off the next block
+    //takes the oversampled ones to the delayed path
+    for (int band = 0; band < numBands; ++band)
+    {
+        if (factorLog2 > 0)
+            getOversampler(band).reset();
+
+        auto& delayLine = delays[static_cast<size_t>(band)];
+        delayLine.setDelay(static_cast<SampleType>(getLatencySamples()));
+        delayLine.reset();
+
+        auto& keyDelay = keyDelays[static_cast<size_t>(band)];
+        keyDelay.setDelay(static_cast<SampleType>(getUpsamplingLatency()));
+        keyDelay.reset();
+    }
+
+    movingBands = fadingBands = 0;
+}
+
+template <typename SampleType>
+int BandOversampler<SampleType>::getLatencySamples() const
+{
+    if (factorLog2 == 0 || numBands == 0)
+        return 0;
+
+    return juce::roundToInt(oversamplers[static_cast<size_t>(factorLog2 - 1)][0]->getLatencyInSamples());
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::setCrossoverFrequency(int index, float newFrequency)
+{
+    jassert(juce::isPositiveAndBelow(index, numBands - 1));
+    crossoverFrequencies[static_cast<size_t>(index)] = newFrequency;
+
+    //a crossover has to go above the edge to take the band below it to the oversampled path,
+    //and well below it to take it back
+    const auto bit = 1u << index;
+    const auto edge = sampleRate / 8.0 * ((crossoversAboveEdge & bit) != 0 ? edgeHysteresis : 1.0);
+    crossoversAboveEdge = newFrequency > edge ? (crossoversAboveEdge | bit) : (crossoversAboveEdge & ~bit);
+}
+
+template <typename SampleType>
+juce::uint32 BandOversampler<SampleType>::getBandsNeedingOversampling() const
+{
+    if (factorLog2 == 0)
+        return 0;
+
+    //the top band always reaches Nyquist, the others stop around the crossover above them
+    return crossoversAboveEdge | (1u << (numBands - 1));
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::beginBlock(juce::uint32 audibleMask, int numSamples, int dynamicsLatency) noexcept
+{
+    const auto wanted = getBandsNeedingOversampling() & audibleMask;
+    const auto warmUpSamples = getLatencySamples() + dynamicsLatency;
+
+    enteringUpsampled = enteringDelayed = 0;
+    juce::uint32 fading = 0;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        const auto bit = 1u << band;
+        const auto wantsUpsampled = (wanted & bit) != 0;
+
+        //a fade that finished last block leaves the band on the path it moved to
+        if ((fadingBands & bit) != 0)
+        {
+            heardUpsampled ^= bit;
+            movingBands &= ~bit;
+        }
+
+        const auto isHeardUpsampled = (heardUpsampled & bit) != 0;
+
+        if (! pathsStarted)
+        {
+            //after reset() every path is silent, so there's nothing to fade from
+            startPath(band, wantsUpsampled);
+            heardUpsampled = wantsUpsampled ? (heardUpsampled | bit) : (heardUpsampled & ~bit);
+        }
+        else if (isHeardUpsampled == wantsUpsampled)
+        {
+            //settled, or turned back before the fade, in which case the path it was entering is dropped
+            movingBands &= ~bit;
+        }
+        else if ((movingBands & bit) == 0)
+        {
+            startPath(band, wantsUpsampled);
+            (wantsUpsampled ? enteringUpsampled : enteringDelayed) |= bit;
+
+            //nobody hears a band that jumps, and with oversampling off there's no path left to fade from
+            if (factorLog2 == 0 || (audibleMask & bit) == 0)
+            {
+                heardUpsampled ^= bit;
+            }
+            else
+            {
+                movingBands |= bit;
+                warmUpLeft[static_cast<size_t>(band)] = warmUpSamples;
+            }
+        }
+
+        //the path a band enters is heard once everything it puts out came in after the band got there
+        if ((movingBands & bit) != 0)
+        {
+            auto& left = warmUpLeft[static_cast<size_t>(band)];
+
+            if (left <= 0)
+                fading |= bit;
+
+            left -= numSamples;
+        }
+    }
+
+    pathsStarted = true;
+    fadingBands = fading;
+
+    const auto allBands = static_cast<juce::uint32>((1u << numBands) - 1);
+    upsampledBands = heardUpsampled | movingBands;
+    delayedBands = (allBands & ~heardUpsampled) | movingBands;
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::startPath(int band, bool upsampled) noexcept
+{
+    if (upsampled)
+    {
+        getOversampler(band).reset();
+        keyDelays[static_cast<size_t>(band)].reset();
+    }
+    else
+        delays[static_cast<size_t>(band)].reset();
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::processUp(const juce::dsp::AudioBlock<SampleType>* bands,
+                                juce::dsp::AudioBlock<SampleType>* oversampledBands,
+                                juce::uint32 bandMask) noexcept
+{
+    jassert(factorLog2 > 0 || bandMask == 0);
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        if ((bandMask & (1u << band)) == 0)
+            continue;
+
+        const auto& block = bands[band];
+        oversampledBands[band] = getOversampler(band).processSamplesUp(juce::dsp::AudioBlock<const SampleType>(block))
+                                                     .getSubsetChannelBlock(0, block.getNumChannels());
+    }
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::processDown(juce::dsp::AudioBlock<SampleType>* bands, juce::uint32 bandMask) noexcept
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        if ((bandMask & (1u << band)) != 0)
+            getOversampler(band).processSamplesDown(bands[band]);
+    }
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::holdKeysUp(const juce::dsp::AudioBlock<const SampleType>* keys,
+                                 juce::dsp::AudioBlock<const SampleType>* oversampledKeys,
+                                 juce::uint32 bandMask) noexcept
+{
+    const auto factor = static_cast<size_t>(getFactor());
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        if ((bandMask & (1u << band)) == 0)
+            continue;
+
+        const auto& key = keys[band];
+        auto& keyBuffer = keyBuffers[static_cast<size_t>(band)];
+        auto& keyDelay = keyDelays[static_cast<size_t>(band)];
+
+        auto numChannels = juce::jmin(key.getNumChannels(), static_cast<size_t>(keyBuffer.getNumChannels()));
+        auto numSamples = key.getNumSamples();
+        jassert(numSamples * factor <= static_cast<size_t>(keyBuffer.getNumSamples()));
+
+        for (size_t c = 0; c < numChannels; ++c)
+        {
+            const auto* src = key.getChannelPointer(c);
+            auto* dst = keyBuffer.getWritePointer(static_cast<int>(c));
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                keyDelay.pushSample(static_cast<int>(c), src[i]);
+                std::fill_n(dst + i * factor, factor, keyDelay.popSample(static_cast<int>(c)));
+            }
+        }
+
+        oversampledKeys[band] = juce::dsp::AudioBlock<const SampleType>(keyBuffer).getSubsetChannelBlock(0, numChannels)
+                                                                              .getSubBlock(0, numSamples * factor);
+    }
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::delay(juce::dsp::AudioBlock<SampleType>* bands, juce::uint32 bandMask) noexcept
+{
+    if (factorLog2 == 0)
+        return;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        if ((bandMask & (1u << band)) == 0)
+            continue;
+
+        auto ctx = juce::dsp::ProcessContextReplacing<SampleType>(bands[band]);
+        delays[static_cast<size_t>(band)].process(ctx);
+    }
+}
+
+template <typename SampleType>
+void BandOversampler<SampleType>::mergePaths(juce::dsp::AudioBlock<SampleType>* bands,
+                                 const juce::dsp::AudioBlock<SampleType>* delayedBands,
+                                 juce::uint32 bandMask) const noexcept
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        const auto bit = 1u << band;
+
+        if ((bandMask & movingBands & bit) == 0)
+            continue;
+
+        auto& block = bands[band];
+        const auto& delayed = delayedBands[band];
+
+        //still warming up: the band is heard from the path it's leaving
+        if ((fadingBands & bit) == 0)
+        {
+            if ((heardUpsampled & bit) == 0)
+                block.copyFrom(delayed);
+
+            continue;
+        }
+
+        //fading: from the path it's leaving to the one it's entering, over the whole block
+        const auto toDelayed = (heardUpsampled & bit) != 0;
+        const auto numSamples = block.getNumSamples();
+
+        for (size_t c = 0; c < block.getNumChannels(); ++c)
+        {
+            auto* upsampled = block.getChannelPointer(c);
+            const auto* delayedSamples = delayed.getChannelPointer(c);
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto progress = static_cast<SampleType>(i + 1) / static_cast<SampleType>(numSamples);
+                auto delayedWeight = toDelayed ? progress : static_cast<SampleType>(1) - progress;
+                upsampled[i] += (delayedSamples[i] - upsampled[i]) * delayedWeight;
+            }
+        }
+    }
+}
+
+template class BandOversampler<float>;
+template class BandOversampler<double>;
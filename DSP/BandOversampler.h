@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    BandOversampler.h
+    Created: 18 Oct 2026 8:03:17pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Oversampling around the band dynamics, for the bands that need it.
+
+ A fast attack at a high ratio modulates the band's gain quickly enough
+ to push sidebands past Nyquist, but only bands whose content reaches up
+ there have anything to fold back. A band is oversampled when its upper
+ edge (the crossover above it, or Nyquist for the top band) is above an
+ eighth of the sample rate; the others run at the host rate. Once a band is
+ oversampled it stays so until its crossover drops a good bit below that
+ edge, so a crossover moving around the edge can't flip it back and forth.
+
+ A band that changes paths while it's heard takes both for a while: the
+ path it enters starts from silence and warms up while the old one is
+ still heard, then mergePaths() crossfades between them over one block.
+ Bands nobody hears, and every band while oversampling is off, go through
+ the delayed path.
+
+ Every band and factor gets its own juce::dsp::Oversampling, allocated in
+ prepare(), so switching factors never allocates. The half-band filters
+ are linear phase with integer latency, and the bands that aren't
+ oversampled go through a plain delay of the same length, so all bands
+ still line up when they are summed.
+ */
+template <typename SampleType>
+class BandOversampler
+{
+public:
+    static constexpr int maxNumBands = 8;
+    static constexpr int maxFactorLog2 = 2;
+
+    void prepare(const juce::dsp::ProcessSpec& spec, int numBands);
+    void reset();
+
+    //0 is off, 1 is 2x, 2 is 4x
+    void setFactorLog2(int newFactorLog2);
+    int getFactorLog2() const { return factorLog2; }
+    int getFactor() const { return 1 << factorLog2; }
+
+    //the same for every band, whether it is oversampled or delayed
+    int getLatencySamples() const;
+
+    void setCrossoverFrequency(int index, float newFrequency);
+
+    //always 0 while oversampling is off
+    juce::uint32 getBandsNeedingOversampling() const;
+
+    /*
+     call once per block, before any band is processed. it picks every band's
+     path and does the per block bookkeeping, so the calls after it can run
+     for disjoint bands on different threads. 'dynamicsLatency' is how long
+     the dynamics take to put out audio they started on from silence (their
+     lookahead), which a band entering a path has to wait out too.
+     */
+    void beginBlock(juce::uint32 audibleMask, int numSamples, int dynamicsLatency) noexcept;
+
+    //the bands going through processUp()/processDown() and through delay() this block.
+    //a band moving between paths is in both, see mergePaths()
+    juce::uint32 getUpsampledBands() const { return upsampledBands; }
+    juce::uint32 getDelayedBands() const { return delayedBands; }
+    juce::uint32 getMovingBands() const { return movingBands; }
+
+    //the bands heard from the oversampled path, which for a moving band is the one it's leaving
+    juce::uint32 getHeardUpsampledBands() const { return heardUpsampled; }
+
+    //bands the last beginBlock() moved onto each path from the other one. their dynamics on
+    //the new path should pick up where the old path's left off
+    juce::uint32 getBandsEnteringUpsampled() const { return enteringUpsampled; }
+    juce::uint32 getBandsEnteringDelayed() const { return enteringDelayed; }
+
+    /*
+     upsamples every band in 'bandMask' into 'oversampledBands' (same index),
+     which stay valid until processDown(). processDown() writes the result
+     back into 'bands'.
+     */
+    void processUp(const juce::dsp::AudioBlock<SampleType>* bands, juce::dsp::AudioBlock<SampleType>* oversampledBands, juce::uint32 bandMask) noexcept;
+    void processDown(juce::dsp::AudioBlock<SampleType>* bands, juce::uint32 bandMask) noexcept;
+
+    /*
+     repeats every sample of keys[band] getFactor() times into 'oversampledKeys',
+     so a sidechain key lines up with its upsampled band. the envelope follower
+     only needs the key's level, so it doesn't get the audio's filtering, only
+     a delay as long as the filters on the way up.
+     */
+    void holdKeysUp(const juce::dsp::AudioBlock<const SampleType>* keys,
+                    juce::dsp::AudioBlock<const SampleType>* oversampledKeys,
+                    juce::uint32 bandMask) noexcept;
+
+    //delays the bands in 'bandMask' by getLatencySamples(), lining them up with the oversampled ones
+    void delay(juce::dsp::AudioBlock<SampleType>* bands, juce::uint32 bandMask) noexcept;
+
+    /*
+     for the moving bands in 'bandMask', bands[band] holds what came out of the
+     oversampled path and delayedBands[band] what came out of the delayed one.
+     leaves what's heard this block in bands[band].
+     */
+    void mergePaths(juce::dsp::AudioBlock<SampleType>* bands,
+                    const juce::dsp::AudioBlock<SampleType>* delayedBands,
+                    juce::uint32 bandMask) const noexcept;
+private:
+    using Oversampling = juce::dsp::Oversampling<SampleType>;
+    using Delay = juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None>;
+
+    double sampleRate = 44100.0;
+    int numBands = 0;
+    int factorLog2 = 0;
+
+    std::array<float, maxNumBands - 1> crossoverFrequencies{};
+
+    //crossovers above the edge, see setCrossoverFrequency(). an oversampled band only
+    //goes back to the host rate once its crossover is below this much of the edge
+    static constexpr double edgeHysteresis = 0.8;
+    juce::uint32 crossoversAboveEdge = 0;
+
+    //[factorLog2 - 1][band]
+    std::array<std::array<std::unique_ptr<Oversampling>, maxNumBands>, maxFactorLog2> oversamplers;
+    std::array<Delay, maxNumBands> delays, keyDelays;
+    std::array<juce::AudioBuffer<SampleType>, maxNumBands> keyBuffers;
+
+    //the filters on the way up and down are about the same length
+    int getUpsamplingLatency() const { return getLatencySamples() / 2; }
+
+    //a band entering a path starts from silence instead of from whatever
+    //that path held when the band last left it
+    bool pathsStarted = false;
+    juce::uint32 heardUpsampled = 0;
+    juce::uint32 movingBands = 0;
+    juce::uint32 fadingBands = 0;
+    std::array<int, maxNumBands> warmUpLeft{};
+
+    //derived from the above in beginBlock()
+    juce::uint32 upsampledBands = 0;
+    juce::uint32 delayedBands = 0;
+    juce::uint32 enteringUpsampled = 0;
+    juce::uint32 enteringDelayed = 0;
+
+    Oversampling& getOversampler(int band) { return *oversamplers[static_cast<size_t>(factorLog2 - 1)][static_cast<size_t>(band)]; }
+    void startPath(int band, bool upsampled) noexcept;
+};
@@ -10,32 +10,51 @@
 
 #include "CompressorBand.h"
 
-void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
+template <typename SampleType>
+void CompressorBand::updateCompressorSettings(const ParameterSnapshot& snapshot, MultiBandCompressor<SampleType>& engine, int bandIndex)
 {
-    compressor.prepare(spec);
+    using namespace Params;
+
+    auto band = [bandIndex](Names name) { return getBandParam(name, bandIndex); };
+
+    if (snapshot.isDirty(band(Names::Attack)))
+        engine.setAttack(bandIndex, snapshot.get(band(Names::Attack)));
+
+    if (snapshot.isDirty(band(Names::Release)))
+        engine.setRelease(bandIndex, snapshot.get(band(Names::Release)));
+
+    if (snapshot.isDirty(band(Names::Threshold)))
+        engine.setThreshold(bandIndex, snapshot.get(band(Names::Threshold)));
+
+    if (snapshot.isDirty(band(Names::Ratio)))
+        engine.setRatio(bandIndex, snapshot.getRatio(band(Names::Ratio)));
 }
 
-void CompressorBand::updateCompressorSettings()
+template <typename SampleType>
+void CompressorBand::updateLevels(const MultiBandCompressor<SampleType>& engine, int bandIndex)
 {
-    compressor.setAttack(attack->get());
-    compressor.setRelease(release->get());
-    compressor.setThreshold(threshold->get());
-    compressor.setRatio(ratio->getCurrentChoiceName().getFloatValue());
+    auto levels = engine.getLevels(bandIndex);
+    rmsInputLevel.store(levels.input);
+    rmsOutputLevel.store(levels.output);
 }
 
-void CompressorBand::process(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+void CompressorBand::updateBypassedLevels(const juce::AudioBuffer<SampleType>& buffer)
 {
-    auto preRMS = computeRMSLevel(buffer);
-    
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
-
-    context.isBypassed = bypassed->get();
-
-    compressor.process(context);
+    auto level = computeRMSLevel(buffer);
+    rmsInputLevel.store(level);
+    rmsOutputLevel.store(level);
+}
 
-    auto postRMS = computeRMSLevel(buffer);
+void CompressorBand::clearLevels()
+{
+    rmsInputLevel.store(juce::Decibels::decibelsToGain(NEGINF));
+    rmsOutputLevel.store(juce::Decibels::decibelsToGain(NEGINF));
+}
 
-    rmsInputLevel.store(juce::Decibels::gainToDecibels(preRMS));
-    rmsOutputLevel.store(juce::Decibels::gainToDecibels(postRMS));
-}
\ No newline at end of file
+template void CompressorBand::updateCompressorSettings<float>(const ParameterSnapshot&, MultiBandCompressor<float>&, int);
+template void CompressorBand::updateCompressorSettings<double>(const ParameterSnapshot&, MultiBandCompressor<double>&, int);
+template void CompressorBand::updateLevels<float>(const MultiBandCompressor<float>&, int);
+template void CompressorBand::updateLevels<double>(const MultiBandCompressor<double>&, int);
+template void CompressorBand::updateBypassedLevels<float>(const juce::AudioBuffer<float>&);
+template void CompressorBand::updateBypassedLevels<double>(const juce::AudioBuffer<double>&);
\ No newline at end of file
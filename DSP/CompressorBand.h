@@ -11,6 +11,8 @@
 #pragma once
 #include <JuceHeader.h>
 #include "../GUI/Utilities.h"
+#include "MultiBandCompressor.h"
+#include "ParameterSnapshot.h"
 
 struct CompressorBand {
     juce::AudioParameterFloat* attack{ nullptr };
@@ -21,19 +23,32 @@ struct CompressorBand {
     juce::AudioParameterBool* mute{ nullptr };
     juce::AudioParameterBool* solo{ nullptr };
 
-    void prepare(const juce::dsp::ProcessSpec& spec);
+    //the dynamics themselves run in MultiBandCompressor, this band is lane 'bandIndex' there.
+    //only settings whose parameter changed in 'snapshot' are pushed to the engine
+    template <typename SampleType>
+    void updateCompressorSettings(const ParameterSnapshot& snapshot, MultiBandCompressor<SampleType>& engine, int bandIndex);
 
-    void updateCompressorSettings();
+    //publishes the levels 'engine' measured while it compressed this band
+    template <typename SampleType>
+    void updateLevels(const MultiBandCompressor<SampleType>& engine, int bandIndex);
 
-    void process(juce::AudioBuffer<float>& buffer);
+    //a bypassed band's output is its input, so one measurement serves both meters
+    template <typename SampleType>
+    void updateBypassedLevels(const juce::AudioBuffer<SampleType>& buffer);
 
-    float getRMSInputLevel() const { return rmsInputLevel; }
-    float getRMSOutputLevel() const { return rmsOutputLevel; }
-private:
-    juce::dsp::Compressor<float> compressor;
+    //for bands that are culled because they are not heard
+    void clearLevels();
+
+    //in dB. the audio thread only stores linear levels, the conversion happens here
+    float getRMSInputLevel() const { return juce::Decibels::gainToDecibels(rmsInputLevel.load()); }
+    float getRMSOutputLevel() const { return juce::Decibels::gainToDecibels(rmsOutputLevel.load()); }
 
-    std::atomic<float> rmsInputLevel{ NEGINF };
-    std::atomic<float> rmsOutputLevel{ NEGINF };
+    //linear, for the audio thread once the band has been processed
+    float getLinearInputLevel() const noexcept { return rmsInputLevel.load(std::memory_order_relaxed); }
+    float getLinearOutputLevel() const noexcept { return rmsOutputLevel.load(std::memory_order_relaxed); }
+private:
+    std::atomic<float> rmsInputLevel{ juce::Decibels::decibelsToGain(NEGINF) };
+    std::atomic<float> rmsOutputLevel{ juce::Decibels::decibelsToGain(NEGINF) };
 
     template <typename T>
     float computeRMSLevel(const T& buffer)
@@ -44,7 +59,7 @@ private:
 
         for (int c = 0; c < numChannels; c++)
         {
-            rms += buffer.getRMSLevel(c, 0, numSamples);
+            rms += static_cast<float>(buffer.getRMSLevel(c, 0, numSamples));
         }
 
         rms /= static_cast<float>(numChannels);
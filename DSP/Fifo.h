@@ -12,9 +12,20 @@
 #include <JuceHeader.h>
 #include <array>
 
-template<typename T>
+/*
+ Single producer, single consumer queue of preallocated T slots.
+
+ Nothing is allocated once the slots are prepared: the producer can fill
+ a slot in place (startWrite() / finishWrite()) or swap an object into it,
+ and the consumer can read a slot in place (startRead() / finishRead())
+ or swap it out. push() and pull() copy into the slot or the destination
+ without reallocating as long as the sizes match, which prepare() sees to.
+ */
+template<typename T, int Capacity = 32>
 struct Fifo
 {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
     void prepare(int numChannels, int numSamples)
     {
         static_assert(std::is_same_v<T, juce::AudioBuffer<float>>,
@@ -41,12 +52,50 @@ struct Fifo
         }
     }
 
+    //producer: the next free slot to fill in place, or nullptr (counted as an overflow) when full
+    T* startWrite()
+    {
+        auto write = writeCount.load(std::memory_order_relaxed);
+        if (write - readCount.load(std::memory_order_acquire) == static_cast<juce::uint32>(Capacity))
+        {
+            overflows.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        return &buffers[write & mask];
+    }
+
+    //producer: hands the slot startWrite() returned to the consumer
+    void finishWrite()
+    {
+        writeCount.store(writeCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    //consumer: the oldest slot to read in place, or nullptr (counted as an underflow) when empty
+    T* startRead()
+    {
+        auto read = readCount.load(std::memory_order_relaxed);
+        if (writeCount.load(std::memory_order_acquire) == read)
+        {
+            underflows.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        return &buffers[read & mask];
+    }
+
+    //consumer: gives the slot startRead() returned back to the producer
+    void finishRead()
+    {
+        readCount.store(readCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
     bool push(const T& t)
     {
-        auto write = fifo.write(1);
-        if (write.blockSize1 > 0)
+        if (auto* slot = startWrite())
         {
-            buffers[write.startIndex1] = t;
+            copyInto(*slot, t);
+            finishWrite();
             return true;
         }
 
@@ -55,10 +104,35 @@ struct Fifo
 
     bool pull(T& t)
     {
-        auto read = fifo.read(1);
-        if (read.blockSize1 > 0)
+        if (auto* slot = startRead())
         {
-            t = buffers[read.startIndex1];
+            copyInto(t, *slot);
+            finishRead();
+            return true;
+        }
+
+        return false;
+    }
+
+    //'t' takes the place of the slot, and comes back holding what the slot held before
+    bool pushBySwapping(T& t)
+    {
+        if (auto* slot = startWrite())
+        {
+            std::swap(*slot, t);
+            finishWrite();
+            return true;
+        }
+
+        return false;
+    }
+
+    bool pullBySwapping(T& t)
+    {
+        if (auto* slot = startRead())
+        {
+            std::swap(*slot, t);
+            finishRead();
             return true;
         }
 
@@ -67,10 +141,38 @@ struct Fifo
 
     int getNumAvailableForReading() const
     {
-        return fifo.getNumReady();
+        return static_cast<int>(writeCount.load(std::memory_order_acquire) - readCount.load(std::memory_order_acquire));
     }
+
+    //writes that found the fifo full, and reads that found it empty
+    juce::uint32 getNumOverflows() const { return overflows.load(std::memory_order_relaxed); }
+    juce::uint32 getNumUnderflows() const { return underflows.load(std::memory_order_relaxed); }
 private:
-    static constexpr int Capacity = 30;
+    static constexpr juce::uint32 mask = static_cast<juce::uint32>(Capacity - 1);
+
     std::array<T, Capacity> buffers;
-    juce::AbstractFifo fifo{ Capacity };
+
+    //free running, the slot is the count masked. they only wrap after 4 billion items, and wrap cleanly
+    std::atomic<juce::uint32> writeCount{ 0 }, readCount{ 0 };
+    std::atomic<juce::uint32> overflows{ 0 }, underflows{ 0 };
+
+    //the prepared slots and the objects they're copied to and from have the same size, so these never reallocate
+    static void copyInto(juce::AudioBuffer<float>& dest, const juce::AudioBuffer<float>& source)
+    {
+        dest.makeCopyOf(source, true);
+    }
+
+    static void copyInto(std::vector<float>& dest, const std::vector<float>& source)
+    {
+        if (dest.size() == source.size())
+            std::copy(source.begin(), source.end(), dest.begin());
+        else
+            dest = source;
+    }
+
+    template<typename U>
+    static void copyInto(U& dest, const U& source)
+    {
+        dest = source;
+    }
 };
@@ -0,0 +1,413 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.cpp
+    Created: 18 Oct 2026 7:12:40pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseCrossover.h"
+
+LinearPhaseCrossover::LinearPhaseCrossover() : juce::Thread("MBComp Linear Phase Kernels")
+{
+    //same default cutoff as LinkwitzRileyCrossover
+    for (auto& frequency : requestedFrequencies)
+    {
+        frequency.store(2000.f);
+    }
+}
+
+LinearPhaseCrossover::~LinearPhaseCrossover()
+{
+    stopThread(1000);
+}
+
+void LinearPhaseCrossover::setNumBands(int newNumBands)
+{
+    jassert(newNumBands >= 2 && newNumBands <= maxNumBands);
+    numBands = juce::jlimit(2, maxNumBands, newNumBands);
+}
+
+void LinearPhaseCrossover::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    stopThread(1000);
+
+    sampleRate = spec.sampleRate;
+    numChannels = static_cast<int>(spec.numChannels);
+
+    //bins about 12 Hz apart whatever the sample rate, which is enough to resolve the lowest crossover
+    kernelLength = juce::nextPowerOfTwo(juce::roundToInt(sampleRate / 12.0));
+    numPartitions = kernelLength / partitionSize;
+
+    auto kernelSize = static_cast<size_t>(numBands * numPartitions * numBins);
+    kernels.forEach([kernelSize](KernelSet& set)
+    {
+        set.real.assign(kernelSize, 0.f);
+        set.imag.assign(kernelSize, 0.f);
+    });
+    kernels.reset();
+
+    auto nc = static_cast<size_t>(numChannels);
+    inputHistory.assign(nc * 2 * partitionSize, 0.f);
+    spectraReal.assign(nc * static_cast<size_t>(numPartitions * numBins), 0.f);
+    spectraImag.assign(nc * static_cast<size_t>(numPartitions * numBins), 0.f);
+    bandOutput.assign(static_cast<size_t>(numBands) * nc * partitionSize, 0.f);
+
+    //juce's real-only transforms work in place on twice the transform size
+    fftScratch.assign(4 * partitionSize, 0.f);
+    accReal.assign(numBins, 0.f);
+    accImag.assign(numBins, 0.f);
+    fadeScratch.assign(partitionSize, 0.f);
+
+    recentInputSize = juce::nextPowerOfTwo((numPartitions + 1) * partitionSize);
+    recentInput.assign(nc * static_cast<size_t>(recentInputSize), 0.f);
+
+    designFFT = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(kernelLength)));
+    designScratch.assign(2 * static_cast<size_t>(kernelLength), 0.f);
+    designPartition.assign(4 * partitionSize, 0.f);
+
+    //periodic Blackman, so the centre tap is exactly 1 and the bands still sum to a delay
+    designWindow.resize(static_cast<size_t>(kernelLength));
+    for (int n = 0; n < kernelLength; ++n)
+    {
+        auto phase = juce::MathConstants<double>::twoPi * n / kernelLength;
+        designWindow[static_cast<size_t>(n)] = static_cast<float>(0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase));
+    }
+
+    //the first kernels are designed here, so the audio thread never runs without any
+    std::array<float, maxNumBands - 1> frequencies;
+    for (size_t i = 0; i < frequencies.size(); ++i)
+    {
+        frequencies[i] = requestedFrequencies[i].load();
+    }
+
+    builtCount = requestCount.load();
+    designKernels(kernels.getWriteBuffer(), frequencies);
+    kernels.publish();
+    kernels.acquire();
+
+    reset();
+
+    startThread();
+}
+
+void LinearPhaseCrossover::reset()
+{
+    std::fill(inputHistory.begin(), inputHistory.end(), 0.f);
+    std::fill(spectraReal.begin(), spectraReal.end(), 0.f);
+    std::fill(spectraImag.begin(), spectraImag.end(), 0.f);
+    std::fill(bandOutput.begin(), bandOutput.end(), 0.f);
+    std::fill(recentInput.begin(), recentInput.end(), 0.f);
+
+    spectrumIndex = 0;
+    fifoPosition = 0;
+    recentInputPosition = 0;
+
+    //catchUp() won't run for a track() from before the reset, so the kernels follow the crossovers again here
+    tracking = false;
+    designing.store(true);
+}
+
+void LinearPhaseCrossover::setCrossoverFrequency(int index, float newFrequency)
+{
+    jassert(juce::isPositiveAndBelow(index, numBands - 1));
+    jassert(juce::isPositiveAndBelow(newFrequency, static_cast<float>(sampleRate * 0.5)));
+
+    auto& requested = requestedFrequencies[static_cast<size_t>(index)];
+    if (requested.load() != newFrequency)
+    {
+        requested.store(newFrequency);
+        requestCount.fetch_add(1);
+    }
+}
+
+void LinearPhaseCrossover::run()
+{
+    while (!threadShouldExit())
+    {
+        //nothing is designed while the crossover is off. a move made meanwhile is picked up when it's back on
+        auto count = requestCount.load();
+        if (count == builtCount || !designing.load())
+        {
+            wait(10);
+            continue;
+        }
+
+        builtCount = count;
+
+        std::array<float, maxNumBands - 1> frequencies;
+        for (size_t i = 0; i < frequencies.size(); ++i)
+        {
+            frequencies[i] = requestedFrequencies[i].load();
+        }
+
+        designKernels(kernels.getWriteBuffer(), frequencies);
+        kernels.publish();
+    }
+}
+
+void LinearPhaseCrossover::designKernels(KernelSet& set, const std::array<float, maxNumBands - 1>& frequencies)
+{
+    const auto half = kernelLength / 2;
+    const auto binWidth = sampleRate / kernelLength;
+
+    //LR4 magnitudes: the lowpass is 1 / (1 + (f/fc)^4) and the highpass is what's left
+    auto lowpass = [](double f, double fc)
+    {
+        auto r = f / fc;
+        return 1.0 / (1.0 + r * r * r * r);
+    };
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        //zero phase spectrum, in the interleaved layout juce's real-only transforms use
+        std::fill(designScratch.begin(), designScratch.end(), 0.f);
+
+        for (int k = 0; k <= half; ++k)
+        {
+            auto f = k * binWidth;
+            auto magnitude = 1.0;
+
+            for (int i = 0; i < band; ++i)
+            {
+                magnitude *= 1.0 - lowpass(f, frequencies[static_cast<size_t>(i)]);
+            }
+
+            if (band < numBands - 1)
+                magnitude *= lowpass(f, frequencies[static_cast<size_t>(band)]);
+
+            designScratch[2 * static_cast<size_t>(k)] = static_cast<float>(magnitude);
+        }
+
+        designFFT->performRealOnlyInverseTransform(designScratch.data());
+
+        //centre the impulse in the kernel, window it and cut it into partitions
+        for (int p = 0; p < numPartitions; ++p)
+        {
+            std::fill(designPartition.begin(), designPartition.end(), 0.f);
+
+            for (int n = 0; n < partitionSize; ++n)
+            {
+                auto tap = p * partitionSize + n;
+                designPartition[static_cast<size_t>(n)] = designScratch[static_cast<size_t>((tap + half) % kernelLength)]
+                                                          * designWindow[static_cast<size_t>(tap)];
+            }
+
+            designPartitionFFT.performRealOnlyForwardTransform(designPartition.data(), true);
+
+            auto offset = getKernelOffset(band, p);
+            for (int k = 0; k < numBins; ++k)
+            {
+                set.real[offset + static_cast<size_t>(k)] = designPartition[2 * static_cast<size_t>(k)];
+                set.imag[offset + static_cast<size_t>(k)] = designPartition[2 * static_cast<size_t>(k) + 1];
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void LinearPhaseCrossover::process(const juce::dsp::AudioBlock<const SampleType>& input,
+                                   juce::dsp::AudioBlock<SampleType>* bands) noexcept
+{
+    const auto nc = static_cast<int>(input.getNumChannels());
+    const auto ns = input.getNumSamples();
+    jassert(nc <= numChannels);
+
+    if (tracking)
+        catchUp();
+
+    remember(input);
+
+    //samples go in and come out one partition later, so any host block size works
+    for (size_t done = 0; done < ns;)
+    {
+        auto n = juce::jmin(static_cast<size_t>(partitionSize - fifoPosition), ns - done);
+
+        for (int ch = 0; ch < nc; ++ch)
+        {
+            auto* history = inputHistory.data() + static_cast<size_t>(ch) * 2 * partitionSize;
+            std::copy_n(input.getChannelPointer(static_cast<size_t>(ch)) + done, n, history + partitionSize + fifoPosition);
+
+            for (int b = 0; b < numBands; ++b)
+            {
+                std::copy_n(getBandOutput(b, ch) + fifoPosition, n, bands[b].getChannelPointer(static_cast<size_t>(ch)) + done);
+            }
+        }
+
+        fifoPosition += static_cast<int>(n);
+        done += n;
+
+        if (fifoPosition == partitionSize)
+        {
+            processPartition(true);
+            fifoPosition = 0;
+        }
+    }
+}
+
+template <typename SampleType>
+void LinearPhaseCrossover::track(const juce::dsp::AudioBlock<const SampleType>& input) noexcept
+{
+    if (!tracking)
+    {
+        tracking = true;
+        designing.store(false);
+    }
+
+    remember(input);
+}
+
+template <typename SampleType>
+void LinearPhaseCrossover::remember(const juce::dsp::AudioBlock<const SampleType>& input) noexcept
+{
+    const auto nc = juce::jmin(static_cast<int>(input.getNumChannels()), numChannels);
+    const auto ns = input.getNumSamples();
+    const auto mask = static_cast<juce::uint32>(recentInputSize - 1);
+
+    for (int ch = 0; ch < nc; ++ch)
+    {
+        const auto* src = input.getChannelPointer(static_cast<size_t>(ch));
+        auto* ring = recentInput.data() + static_cast<size_t>(ch) * static_cast<size_t>(recentInputSize);
+
+        for (size_t i = 0; i < ns; ++i)
+        {
+            ring[(recentInputPosition + static_cast<juce::uint32>(i)) & mask] = static_cast<float>(src[i]);
+        }
+    }
+
+    recentInputPosition += static_cast<juce::uint32>(ns);
+}
+
+template void LinearPhaseCrossover::process<float>(const juce::dsp::AudioBlock<const float>&, juce::dsp::AudioBlock<float>*) noexcept;
+template void LinearPhaseCrossover::process<double>(const juce::dsp::AudioBlock<const double>&, juce::dsp::AudioBlock<double>*) noexcept;
+template void LinearPhaseCrossover::track<float>(const juce::dsp::AudioBlock<const float>&) noexcept;
+template void LinearPhaseCrossover::track<double>(const juce::dsp::AudioBlock<const double>&) noexcept;
+
+void LinearPhaseCrossover::catchUp() noexcept
+{
+    //replays the last numPartitions + 1 partitions of input: the first only fills the older half of
+    //the history, the rest refill every spectrum slot. the last one also renders its output, which
+    //comes out over the next partition exactly as it would have if process() had run all along
+    const auto mask = static_cast<juce::uint32>(recentInputSize - 1);
+    auto position = recentInputPosition - static_cast<juce::uint32>((numPartitions + 1) * partitionSize);
+
+    for (int p = 0; p <= numPartitions; ++p)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* ring = recentInput.data() + static_cast<size_t>(ch) * static_cast<size_t>(recentInputSize);
+            auto* history = inputHistory.data() + static_cast<size_t>(ch) * 2 * partitionSize;
+
+            for (int n = 0; n < partitionSize; ++n)
+            {
+                history[partitionSize + n] = ring[(position + static_cast<juce::uint32>(n)) & mask];
+            }
+        }
+
+        processPartition(p == numPartitions);
+        position += static_cast<juce::uint32>(partitionSize);
+    }
+
+    fifoPosition = 0;
+    tracking = false;
+    designing.store(true);
+}
+
+void LinearPhaseCrossover::processPartition(bool render) noexcept
+{
+    //the input spectra are shared by every band
+    spectrumIndex = (spectrumIndex + 1) % numPartitions;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* history = inputHistory.data() + static_cast<size_t>(ch) * 2 * partitionSize;
+
+        std::copy_n(history, 2 * partitionSize, fftScratch.data());
+        std::fill(fftScratch.begin() + 2 * partitionSize, fftScratch.end(), 0.f);
+        partitionFFT.performRealOnlyForwardTransform(fftScratch.data(), true);
+
+        auto offset = getSpectrumOffset(ch, spectrumIndex);
+        for (int k = 0; k < numBins; ++k)
+        {
+            spectraReal[offset + static_cast<size_t>(k)] = fftScratch[2 * static_cast<size_t>(k)];
+            spectraImag[offset + static_cast<size_t>(k)] = fftScratch[2 * static_cast<size_t>(k) + 1];
+        }
+
+        //the newest half is the older half of the next partition's transform
+        std::copy_n(history + partitionSize, partitionSize, history);
+    }
+
+    if (!render)
+        return;
+
+    //new kernels from the design thread are faded in over this partition
+    auto fadeIn = kernels.hasNewData();
+
+    for (int b = 0; b < numBands; ++b)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            convolve(kernels.getReadBuffer(), b, ch, getBandOutput(b, ch));
+        }
+    }
+
+    if (fadeIn && kernels.acquire())
+    {
+        for (int b = 0; b < numBands; ++b)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* output = getBandOutput(b, ch);
+                convolve(kernels.getReadBuffer(), b, ch, fadeScratch.data());
+
+                for (int n = 0; n < partitionSize; ++n)
+                {
+                    auto amount = static_cast<float>(n + 1) / partitionSize;
+                    output[n] += (fadeScratch[static_cast<size_t>(n)] - output[n]) * amount;
+                }
+            }
+        }
+    }
+}
+
+void LinearPhaseCrossover::convolve(const KernelSet& set, int band, int channel, float* output) noexcept
+{
+    std::fill(accReal.begin(), accReal.end(), 0.f);
+    std::fill(accImag.begin(), accImag.end(), 0.f);
+
+    auto* ar = accReal.data();
+    auto* ai = accImag.data();
+
+    //partition p of the kernel meets the input spectrum from p partitions ago
+    for (int p = 0; p < numPartitions; ++p)
+    {
+        auto slot = (spectrumIndex - p + numPartitions) % numPartitions;
+
+        const auto* xr = spectraReal.data() + getSpectrumOffset(channel, slot);
+        const auto* xi = spectraImag.data() + getSpectrumOffset(channel, slot);
+        const auto* hr = set.real.data() + getKernelOffset(band, p);
+        const auto* hi = set.imag.data() + getKernelOffset(band, p);
+
+        for (int k = 0; k < numBins; ++k)
+        {
+            ar[k] += xr[k] * hr[k] - xi[k] * hi[k];
+            ai[k] += xr[k] * hi[k] + xi[k] * hr[k];
+        }
+    }
+
+    for (int k = 0; k < numBins; ++k)
+    {
+        fftScratch[2 * static_cast<size_t>(k)] = ar[k];
+        fftScratch[2 * static_cast<size_t>(k) + 1] = ai[k];
+    }
+
+    partitionFFT.performRealOnlyInverseTransform(fftScratch.data());
+
+    //overlap-save: only the second half of the circular convolution is valid
+    std::copy_n(fftScratch.data() + partitionSize, partitionSize, output);
+}
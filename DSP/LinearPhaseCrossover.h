@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.h
+    Created: 18 Oct 2026 7:12:40pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TripleBuffer.h"
+
+/*
+ Linear phase N-band crossover.
+
+ Each band gets a symmetric FIR kernel with the magnitude response of the
+ Linkwitz-Riley tree (|LP| = 1 / (1 + (f/fc)^4), |HP| = 1 - |LP|) and no
+ phase shift. The band magnitudes sum to exactly one and every kernel uses
+ the same window, so the bands still add back up to a pure delay.
+
+ The kernels run as uniformly partitioned overlap-save convolution: the
+ input is transformed once per channel per partition, and every band
+ multiply-accumulates the last numPartitions input spectra against its
+ kernel partitions. Partitions are short (partitionSize samples), so the
+ work is spread evenly over small host blocks instead of landing on one
+ of them.
+
+ Kernels are designed on a background thread whenever a crossover moves
+ and handed to the audio thread through a TripleBuffer; the audio thread
+ crossfades from the old to the new kernels over one partition.
+
+ Latency is getLatencySamples(): half the kernel plus one partition.
+
+ While the crossover is off, track() only keeps the last kernel's worth
+ of input (process() keeps it too) and the kernel thread stops designing.
+ The next process() rebuilds the input spectra from that input and picks
+ up with no gap, as if it had been running all along.
+ */
+class LinearPhaseCrossover : private juce::Thread
+{
+public:
+    static constexpr int maxNumBands = 8;
+    static constexpr int partitionSize = 64;
+
+    LinearPhaseCrossover();
+    ~LinearPhaseCrossover() override;
+
+    void setNumBands(int newNumBands);
+    int getNumBands() const { return numBands; }
+
+    //designs the first kernels before returning, then starts the kernel thread
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    //cheap and lock free, safe to call from the audio thread every block
+    void setCrossoverFrequency(int index, float newFrequency);
+
+    int getLatencySamples() const { return kernelLength / 2 + partitionSize; }
+
+    /*
+     splits 'input' into getNumBands() blocks, lowest band first.
+     each band block needs at least as many channels and samples as 'input'.
+     float or double: the convolution runs in float either way, and samples
+     change type in the partition copies it already makes
+     */
+    template <typename SampleType>
+    void process(const juce::dsp::AudioBlock<const SampleType>& input,
+                 juce::dsp::AudioBlock<SampleType>* bands) noexcept;
+
+    //call instead of process() while the crossover is off, with the same input
+    template <typename SampleType>
+    void track(const juce::dsp::AudioBlock<const SampleType>& input) noexcept;
+private:
+    static constexpr int numBins = partitionSize + 1;
+
+    //every band's kernel as numPartitions spectra, split into real and imaginary parts
+    struct KernelSet
+    {
+        std::vector<float> real, imag;
+    };
+
+    int numBands = 3;
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+    int kernelLength = 0;
+    int numPartitions = 0;
+
+    std::array<std::atomic<float>, maxNumBands - 1> requestedFrequencies;
+    std::atomic<int> requestCount{ 0 };
+    int builtCount = 0;
+
+    TripleBuffer<KernelSet> kernels;
+
+    //audio thread state. input spectra are a ring of numPartitions, newest at spectrumIndex
+    juce::dsp::FFT partitionFFT{ juce::roundToInt(std::log2(2 * partitionSize)) };
+    std::vector<float> inputHistory;     //per channel: the last 2 * partitionSize input samples
+    std::vector<float> spectraReal, spectraImag;
+    std::vector<float> bandOutput;       //per band and channel: partitionSize samples
+    std::vector<float> fftScratch, accReal, accImag, fadeScratch;
+    int spectrumIndex = 0;
+    int fifoPosition = 0;
+
+    //per channel, a ring of at least numPartitions + 1 partitions of the latest input, for catchUp()
+    std::vector<float> recentInput;
+    int recentInputSize = 0;
+    juce::uint32 recentInputPosition = 0;
+    bool tracking = false;
+
+    //false while the crossover is off, so the kernel thread leaves the kernels alone
+    std::atomic<bool> designing{ true };
+
+    //kernel thread state
+    std::unique_ptr<juce::dsp::FFT> designFFT;
+    juce::dsp::FFT designPartitionFFT{ juce::roundToInt(std::log2(2 * partitionSize)) };
+    std::vector<float> designScratch, designWindow, designPartition;
+
+    void run() override;
+
+    void designKernels(KernelSet& set, const std::array<float, maxNumBands - 1>& frequencies);
+    template <typename SampleType>
+    void remember(const juce::dsp::AudioBlock<const SampleType>& input) noexcept;
+    void catchUp() noexcept;
+
+    //'render' is false while catchUp() only rebuilds the input spectra
+    void processPartition(bool render) noexcept;
+    void convolve(const KernelSet& set, int band, int channel, float* output) noexcept;
+
+    size_t getKernelOffset(int band, int partition) const { return static_cast<size_t>((band * numPartitions + partition) * numBins); }
+    size_t getSpectrumOffset(int channel, int slot) const { return static_cast<size_t>((channel * numPartitions + slot) * numBins); }
+    float* getBandOutput(int band, int channel) { return bandOutput.data() + static_cast<size_t>((band * numChannels + channel) * partitionSize); }
+};
@@ -0,0 +1,336 @@
+/*
+  ==============================================================================
+
+    LinkwitzRileyCrossover.cpp
+    Created: 18 Oct 2026 1:47:12pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include "LinkwitzRileyCrossover.h"
+
+template <typename SampleType>
+LinkwitzRileyCrossover<SampleType>::LinkwitzRileyCrossover()
+{
+    //same default cutoff as juce::dsp::LinkwitzRileyFilter
+    frequencies.fill(static_cast<SampleType>(2000.0));
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::setNumBands(int newNumBands)
+{
+    jassert(newNumBands >= 2 && newNumBands <= maxNumBands);
+    numBands = juce::jlimit(2, maxNumBands, newNumBands);
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    constexpr auto W = Register::SIMDNumElements;
+
+    sampleRate = spec.sampleRate;
+    numChannels = static_cast<size_t>(spec.numChannels);
+    numGroups = (numChannels + W - 1) / W;
+    numSVFsPerGroup = getFirstSVF(numBands - 1);
+
+    states.resize(numGroups * numSVFsPerGroup);
+    coefficients.resize(static_cast<size_t>(numBands - 1));
+
+    //up to where the cutoff would fold over, tan() only grows steeper past it
+    auto numEntries = static_cast<size_t>(std::ceil((std::log2(0.49 * sampleRate) - tableMinOctave) * tableStepsPerOctave)) + 2;
+    gTable.resize(numEntries);
+    for (size_t i = 0; i < numEntries; ++i)
+    {
+        auto frequency = std::exp2(tableMinOctave + static_cast<double>(i) / tableStepsPerOctave);
+        gTable[i] = std::tan(juce::MathConstants<double>::pi * juce::jmin(frequency, 0.49 * sampleRate) / sampleRate);
+    }
+
+    smoothingSteps = juce::roundToInt(smoothingSeconds * sampleRate / controlInterval);
+
+    //one aligned tile for the input and one per band, plus slack for the alignment
+    scratchMemory.allocate((static_cast<size_t>(numBands) + 1) * tileSize * W + W, true);
+    inputScratch = Register::getNextSIMDAlignedPtr(scratchMemory.get());
+    bandScratch = inputScratch + tileSize * W;
+
+    for (int i = 0; i < numBands - 1; ++i)
+    {
+        updateCoefficients(i);
+    }
+
+    reset();
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::reset()
+{
+    auto zero = Register::expand(static_cast<SampleType>(0));
+
+    for (auto& state : states)
+    {
+        state.s1 = zero;
+        state.s2 = zero;
+    }
+
+    //with the state cleared there's nothing to glide from
+    for (size_t i = 0; i < coefficients.size(); ++i)
+    {
+        glides[i] = { std::log2(static_cast<double>(frequencies[i])), 0.0, 0 };
+        updateCoefficients(static_cast<int>(i));
+    }
+
+    numGliding = 0;
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::setSmoothing(double rampSeconds, int newControlInterval)
+{
+    jassert(rampSeconds >= 0.0);
+    jassert(newControlInterval > 0);
+
+    smoothingSeconds = juce::jmax(0.0, rampSeconds);
+    controlInterval = juce::jmax(1, newControlInterval);
+    smoothingSteps = juce::roundToInt(smoothingSeconds * sampleRate / controlInterval);
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::setCrossoverFrequency(int index, SampleType newFrequency)
+{
+    jassert(juce::isPositiveAndBelow(index, numBands - 1));
+    jassert(juce::isPositiveAndBelow(newFrequency, static_cast<SampleType>(sampleRate * 0.5)));
+
+    auto i = static_cast<size_t>(index);
+    auto unchanged = newFrequency == frequencies[i];
+    frequencies[i] = newFrequency;
+
+    //not prepared yet, prepare() picks the frequency up
+    if (i >= coefficients.size())
+        return;
+
+    auto& glide = glides[i];
+
+    if (smoothingSteps == 0)
+    {
+        numGliding -= glide.stepsLeft > 0 ? 1 : 0;
+        glide = { std::log2(static_cast<double>(newFrequency)), 0.0, 0 };
+        updateCoefficients(index);
+        return;
+    }
+
+    if (unchanged && glide.stepsLeft == 0)
+        return;
+
+    if (glide.stepsLeft == 0)
+    {
+        if (numGliding++ == 0)
+            samplesToControl = controlInterval;
+    }
+
+    //a glide that's under way turns towards the new target from wherever it got to
+    glide.increment = (std::log2(static_cast<double>(newFrequency)) - glide.position) / smoothingSteps;
+    glide.stepsLeft = smoothingSteps;
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::updateCoefficients(int index)
+{
+    setCoefficients(index, static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * frequencies[static_cast<size_t>(index)] / sampleRate)));
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::setCoefficients(int index, SampleType g)
+{
+    //written exactly like LinkwitzRileyFilter::update() so the rounding matches
+    auto R2 = static_cast<SampleType>(std::sqrt(2.0));
+    auto h = static_cast<SampleType>(1.0 / (1.0 + R2 * g + g * g));
+
+    auto& c = coefficients[static_cast<size_t>(index)];
+    c.g = Register::expand(g);
+    c.R2 = Register::expand(R2);
+    c.R2g = Register::expand(R2 + g);
+    c.h = Register::expand(h);
+}
+
+template <typename SampleType>
+SampleType LinkwitzRileyCrossover<SampleType>::lookUpG(double octave) const noexcept
+{
+    auto position = juce::jlimit(0.0, static_cast<double>(gTable.size() - 2), (octave - tableMinOctave) * tableStepsPerOctave);
+    auto i = static_cast<size_t>(position);
+    auto fraction = position - static_cast<double>(i);
+
+    return static_cast<SampleType>(gTable[i] + fraction * (gTable[i + 1] - gTable[i]));
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::advanceGlides() noexcept
+{
+    for (size_t i = 0; i < coefficients.size(); ++i)
+    {
+        auto& glide = glides[i];
+        if (glide.stepsLeft == 0)
+            continue;
+
+        if (--glide.stepsLeft > 0)
+        {
+            glide.position += glide.increment;
+            setCoefficients(static_cast<int>(i), lookUpG(glide.position));
+        }
+        else
+        {
+            //the last step lands exactly on the target, as if it had been set without a glide
+            glide.position = std::log2(static_cast<double>(frequencies[i]));
+            updateCoefficients(static_cast<int>(i));
+            --numGliding;
+        }
+    }
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::process(const juce::dsp::AudioBlock<const SampleType>& input,
+                                                 juce::dsp::AudioBlock<SampleType>* bands) noexcept
+{
+    constexpr auto W = Register::SIMDNumElements;
+
+    const auto nc = input.getNumChannels();
+    const auto ns = input.getNumSamples();
+    jassert(nc <= numChannels);
+
+    //every group has to see the same coefficients at the same sample, so time is the outer loop
+    for (size_t start = 0; start < ns;)
+    {
+        auto numFrames = juce::jmin(tileSize, ns - start);
+
+        //while a cutoff glides, tiles end on the control steps
+        if (numGliding > 0)
+            numFrames = juce::jmin(numFrames, static_cast<size_t>(samplesToControl));
+
+        for (size_t group = 0; group * W < nc; ++group)
+        {
+            const auto firstChannel = group * W;
+            const auto numLanes = juce::jmin(W, nc - firstChannel);
+            auto* groupState = states.data() + group * numSVFsPerGroup;
+
+            //unused lanes of a partly filled group just run on silence
+            if (numLanes < W)
+                std::fill(inputScratch, inputScratch + numFrames * W, static_cast<SampleType>(0));
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                auto* src = input.getChannelPointer(firstChannel + lane) + start;
+                for (size_t t = 0; t < numFrames; ++t)
+                {
+                    inputScratch[t * W + lane] = src[t];
+                }
+            }
+
+            processTile(groupState, numFrames);
+
+            for (int b = 0; b < numBands; ++b)
+            {
+                auto* tile = bandScratch + static_cast<size_t>(b) * tileSize * W;
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                {
+                    auto* dst = bands[b].getChannelPointer(firstChannel + lane) + start;
+                    for (size_t t = 0; t < numFrames; ++t)
+                    {
+                        dst[t] = tile[t * W + lane];
+                    }
+                }
+            }
+        }
+
+        start += numFrames;
+
+        if (numGliding > 0 && (samplesToControl -= static_cast<int>(numFrames)) == 0)
+        {
+            advanceGlides();
+            samplesToControl = controlInterval;
+        }
+    }
+
+   #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+    snapToZero();
+   #endif
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::processTile(SVFState* groupState, size_t numFrames) noexcept
+{
+    constexpr auto W = Register::SIMDNumElements;
+    const auto numCrossovers = numBands - 1;
+
+    //one TPT state variable section, as in LinkwitzRileyFilter::processSample()
+    auto tick = [](SVFState& s, const Coefficients& c, Register x, Register& yL, Register& yB, Register& yH)
+    {
+        yH = (x - c.R2g * s.s1 - s.s2) * c.h;
+
+        yB = c.g * yH + s.s1;
+        s.s1 = c.g * yH + yB;
+
+        yL = c.g * yB + s.s2;
+        s.s2 = c.g * yB + yL;
+    };
+
+    std::array<Register, maxNumBands> out;
+
+    for (size_t t = 0; t < numFrames; ++t)
+    {
+        auto v = Register::fromRawArray(inputScratch + t * W);
+
+        for (int i = 0; i < numCrossovers; ++i)
+        {
+            const auto& c = coefficients[static_cast<size_t>(i)];
+            auto* svf = groupState + getFirstSVF(i);
+
+            Register yL, yB, yH, lo, hi, unusedB, unusedX;
+
+            //the LP and HP of a crossover share their first section
+            tick(svf[0], c, v, yL, yB, yH);
+            tick(svf[1], c, yL, lo, unusedB, unusedX);
+            tick(svf[2], c, yH, unusedX, unusedB, hi);
+
+            //allpass the bands already split off so they stay in phase with this split
+            for (int b = 0; b < i; ++b)
+            {
+                Register apL, apB, apH;
+                tick(svf[3 + b], c, out[static_cast<size_t>(b)], apL, apB, apH);
+                out[static_cast<size_t>(b)] = apL - c.R2 * apB + apH;
+            }
+
+            out[static_cast<size_t>(i)] = lo;
+            v = hi;
+        }
+
+        out[static_cast<size_t>(numCrossovers)] = v;
+
+        for (int b = 0; b < numBands; ++b)
+        {
+            out[static_cast<size_t>(b)].copyToRawArray(bandScratch + (static_cast<size_t>(b) * tileSize + t) * W);
+        }
+    }
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::snapToZero() noexcept
+{
+    //lane-wise version of juce::dsp::util::snapToZero()
+    auto upper = Register::expand(static_cast<SampleType>(1.0e-8));
+    auto lower = Register::expand(static_cast<SampleType>(-1.0e-8));
+
+    auto snap = [upper, lower](Register& r)
+    {
+        r = r & (Register::greaterThan(r, upper) | Register::lessThan(r, lower));
+    };
+
+    for (auto& state : states)
+    {
+        snap(state.s1);
+        snap(state.s2);
+    }
+}
+
+template class LinkwitzRileyCrossover<float>;
+template class LinkwitzRileyCrossover<double>;
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    LinkwitzRileyCrossover.h
+    Created: 18 Oct 2026 1:47:12pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Fused N-band Linkwitz-Riley (LR4) crossover tree.
+
+ Runs the same tree the processor used to build out of separate
+ juce::dsp::LinkwitzRileyFilter objects (LP1 -> AP2 for the low band,
+ HP1 -> LP2 / HP2 for the mid and high bands, generalised to N bands),
+ but in a single pass per sample frame:
+  - channels are packed into the lanes of a juce::dsp::SIMDRegister,
+  - the first state-variable section of each LP/HP pair is shared,
+    since both filters see the same input with the same cutoff,
+  - phase compensation allpasses for the lower bands run in the same loop.
+
+ A new cutoff isn't jumped to: it glides there in equal steps on a log
+ frequency scale, one step every control interval. The steps in between
+ read their coefficient from a table built for the sample rate in
+ prepare() instead of calling tan(), and only the last step computes the
+ exact one, so a crossover that isn't moving is unchanged.
+
+ The coefficient and state update maths are the ones LinkwitzRileyFilter
+ uses, so outputs match it to float rounding (bit-exact unless the compiler
+ contracts to FMA differently for the two versions). The benchmark tool
+ reports the measured deviation.
+ */
+template <typename SampleType>
+class LinkwitzRileyCrossover
+{
+public:
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int maxNumBands = 8;
+
+    static constexpr double defaultSmoothingSeconds = 0.05;
+    static constexpr int defaultControlInterval = 16;
+
+    LinkwitzRileyCrossover();
+
+    void setNumBands(int newNumBands);
+    int getNumBands() const { return numBands; }
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void setCrossoverFrequency(int index, SampleType newFrequency);
+    SampleType getCrossoverFrequency(int index) const { return frequencies[static_cast<size_t>(index)]; }
+
+    //how long a cutoff takes to glide to a new frequency, and the samples between two of its steps.
+    //0 seconds jumps straight there. call before prepare()
+    void setSmoothing(double rampSeconds, int controlInterval);
+
+    /*
+     splits 'input' into getNumBands() blocks, lowest band first.
+     each band block needs at least as many channels and samples as 'input'.
+     */
+    void process(const juce::dsp::AudioBlock<const SampleType>& input,
+                 juce::dsp::AudioBlock<SampleType>* bands) noexcept;
+private:
+    struct Coefficients
+    {
+        Register g, R2, R2g, h;
+    };
+
+    struct SVFState
+    {
+        Register s1, s2;
+    };
+
+    //where a crossover is on its way to frequencies[index], in octaves
+    struct Glide
+    {
+        double position = 0.0;
+        double increment = 0.0;
+        int stepsLeft = 0;
+    };
+
+    //frames interleaved into the scratch buffers per pass
+    static constexpr size_t tileSize = 64;
+
+    int numBands = 3;
+    double sampleRate = 44100.0;
+    size_t numChannels = 0;
+    size_t numGroups = 0;
+    size_t numSVFsPerGroup = 0;
+
+    std::array<SampleType, maxNumBands - 1> frequencies{};
+    std::vector<Coefficients> coefficients;
+    std::vector<SVFState> states;
+
+    double smoothingSeconds = defaultSmoothingSeconds;
+    int controlInterval = defaultControlInterval;
+    int smoothingSteps = 0;
+
+    std::array<Glide, maxNumBands - 1> glides;
+    int numGliding = 0;
+    int samplesToControl = 0;
+
+    //the prewarped cutoff g = tan(pi f / fs) at every 1/64 octave from 10 Hz, for the glide steps
+    static constexpr double tableStepsPerOctave = 64.0;
+    static constexpr double tableMinOctave = 3.321928094887362; //log2(10)
+    std::vector<double> gTable;
+
+    juce::HeapBlock<SampleType> scratchMemory;
+    SampleType* inputScratch = nullptr;
+    SampleType* bandScratch = nullptr;
+
+    //per crossover: shared section, LP second section, HP second section,
+    //then one allpass for every band that has already been split off
+    static size_t getFirstSVF(int crossover) { return static_cast<size_t>(3 * crossover + crossover * (crossover - 1) / 2); }
+
+    void updateCoefficients(int index);
+    void setCoefficients(int index, SampleType g);
+    SampleType lookUpG(double octave) const noexcept;
+    void advanceGlides() noexcept;
+    void processTile(SVFState* groupState, size_t numFrames) noexcept;
+    void snapToZero() noexcept;
+};
@@ -0,0 +1,342 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 18 Oct 2026 11:02:26pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+
+namespace
+{
+    //BS.1770-4 Annex 2, one row per phase
+    constexpr float truePeakTaps[4][12]
+    {
+        {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f, -0.0594482421875f,  0.1373291015625f,
+           0.9721679687500f, -0.1022949218750f,  0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+        { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f, -0.1665039062500f,  0.4650878906250f,
+           0.7797851562500f, -0.2003173828125f,  0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+        { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f, -0.2003173828125f,  0.7797851562500f,
+           0.4650878906250f, -0.1665039062500f,  0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+        { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f, -0.1022949218750f,  0.9721679687500f,
+           0.1373291015625f, -0.0594482421875f,  0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f },
+    };
+}
+
+void LoudnessMeter::prepare(double newSampleRate, int newNumChannels)
+{
+    jassert(newSampleRate > 0);
+    jassert(newNumChannels > 0 && newNumChannels <= maxNumChannels);
+
+    sampleRate = newSampleRate;
+    numChannels = juce::jlimit(1, maxNumChannels, newNumChannels);
+    numGroups = (static_cast<size_t>(numChannels) + Register::SIMDNumElements - 1) / Register::SIMDNumElements;
+
+    stepSamples = juce::jmax(1, juce::roundToInt(sampleRate / 10.0));
+
+    //the pre-filter designed for this rate, as the 48 kHz coefficients of BS.1770 are derived
+    {
+        const auto f0 = 1681.974450955533;
+        const auto gainDb = 3.999843853973347;
+        const auto q = 0.7071752369554196;
+
+        const auto k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const auto vh = std::pow(10.0, gainDb / 20.0);
+        const auto vb = std::pow(vh, 0.4996667741545416);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        shelf = { static_cast<float>((vh + vb * k / q + k * k) / a0),
+                  static_cast<float>(2.0 * (k * k - vh) / a0),
+                  static_cast<float>((vh - vb * k / q + k * k) / a0),
+                  static_cast<float>(2.0 * (k * k - 1.0) / a0),
+                  static_cast<float>((1.0 - k / q + k * k) / a0) };
+    }
+
+    {
+        const auto f0 = 38.13547087602444;
+        const auto q = 0.5003270373238773;
+
+        const auto k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        highpass = { 1.f, -2.f, 1.f,
+                     static_cast<float>(2.0 * (k * k - 1.0) / a0),
+                     static_cast<float>((1.0 - k / q + k * k) / a0) };
+    }
+
+    channelWeights.fill(1.f);
+
+    //reset() publishes cleared readings. resetting the TripleBuffer itself would race the editor's reads
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    for (auto& group : groups)
+    {
+        group = {};
+    }
+
+    historyIndex = 0;
+    stepPosition = 0;
+
+    stepEnergies.fill(0.0);
+    stepIndex = 0;
+    numSteps = 0;
+
+    binCounts.fill(0);
+    binEnergies.fill(0.0);
+    gatedCount = 0;
+    gatedEnergy = 0.0;
+
+    current = {};
+    published.getWriteBuffer() = current;
+    published.publish();
+}
+
+void LoudnessMeter::setChannelWeights(const std::array<float, maxNumChannels>& weights) noexcept
+{
+    channelWeights = weights;
+}
+
+template <typename SampleType>
+void LoudnessMeter::process(const juce::dsp::AudioBlock<const SampleType>& block) noexcept
+{
+    constexpr auto W = Register::SIMDNumElements;
+
+    if (resetRequested.exchange(false))
+        reset();
+
+    const auto blockChannels = juce::jmin(block.getNumChannels(), static_cast<size_t>(numChannels));
+    const auto numSamples = block.getNumSamples();
+
+    for (size_t start = 0; start < numSamples;)
+    {
+        //tiles never straddle a step, so a step's energy is complete when it ends
+        const auto numFrames = juce::jmin(tileSize, numSamples - start, static_cast<size_t>(stepSamples - stepPosition));
+
+        for (size_t g = 0; g < numGroups; ++g)
+        {
+            for (size_t l = 0; l < W; ++l)
+            {
+                auto channel = g * W + l;
+
+                if (channel < blockChannels)
+                {
+                    const auto* src = block.getChannelPointer(channel) + start;
+                    for (size_t t = 0; t < numFrames; ++t)
+                    {
+                        tile[t * W + l] = static_cast<float>(src[t]);
+                    }
+                }
+                else
+                {
+                    for (size_t t = 0; t < numFrames; ++t)
+                    {
+                        tile[t * W + l] = 0.f;
+                    }
+                }
+            }
+
+            processTile(groups[g], numFrames);
+        }
+
+        historyIndex = static_cast<int>((static_cast<size_t>(historyIndex) + numFrames) % numTaps);
+        stepPosition += static_cast<int>(numFrames);
+        start += numFrames;
+
+        if (stepPosition == stepSamples)
+            endStep();
+    }
+}
+
+void LoudnessMeter::processTile(Group& group, size_t numFrames) noexcept
+{
+    constexpr auto W = Register::SIMDNumElements;
+
+    const auto zero = Register::expand(0.f);
+
+    auto section = [](SectionState& state, const Coefficients& c, Register x)
+    {
+        auto y = x * c.b0 + state.s1;
+        state.s1 = x * c.b1 - y * c.a1 + state.s2;
+        state.s2 = x * c.b2 - y * c.a2;
+        return y;
+    };
+
+    auto energy = group.energy;
+    auto peak = group.peak;
+    auto index = historyIndex;
+
+    for (size_t t = 0; t < numFrames; ++t)
+    {
+        auto x = Register::fromRawArray(tile + t * W);
+
+        auto weighted = section(group.highpass, highpass, section(group.shelf, shelf, x));
+        energy += weighted * weighted;
+
+        //history[index + 1 .. index + numTaps] holds the last numTaps inputs, newest last
+        group.history[static_cast<size_t>(index)] = x;
+        group.history[static_cast<size_t>(index + numTaps)] = x;
+        const auto* window = group.history.data() + index + 1;
+
+        peak = Register::max(peak, Register::max(x, zero - x));
+
+        for (const auto& taps : truePeakTaps)
+        {
+            auto y = zero;
+            for (int k = 0; k < numTaps; ++k)
+            {
+                y += window[numTaps - 1 - k] * taps[k];
+            }
+
+            peak = Register::max(peak, Register::max(y, zero - y));
+        }
+
+        index = index + 1 == numTaps ? 0 : index + 1;
+    }
+
+    group.energy = energy;
+    group.peak = peak;
+}
+
+void LoudnessMeter::endStep() noexcept
+{
+    constexpr auto W = Register::SIMDNumElements;
+    alignas(Register) float laneValues[W];
+
+    auto stepEnergy = 0.0;
+
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+        auto& group = groups[g];
+
+        group.energy.copyToRawArray(laneValues);
+        for (size_t l = 0; l < W && g * W + l < static_cast<size_t>(numChannels); ++l)
+        {
+            stepEnergy += channelWeights[g * W + l] * static_cast<double>(laneValues[l]);
+        }
+
+        group.energy = Register::expand(0.f);
+    }
+
+    stepEnergies[static_cast<size_t>(stepIndex)] = stepEnergy;
+    stepIndex = (stepIndex + 1) % shortTermSteps;
+    stepPosition = 0;
+    ++numSteps;
+
+    //windows that reach back before the first step count that time as silence
+    auto sumSteps = [this](int count)
+    {
+        auto sum = 0.0;
+        for (int i = 1; i <= count; ++i)
+        {
+            sum += stepEnergies[static_cast<size_t>((stepIndex - i + shortTermSteps) % shortTermSteps)];
+        }
+        return sum;
+    };
+
+    auto momentaryEnergy = sumSteps(momentarySteps) / (momentarySteps * static_cast<double>(stepSamples));
+    auto shortTermEnergy = sumSteps(shortTermSteps) / (shortTermSteps * static_cast<double>(stepSamples));
+
+    current.momentary = toLoudness(momentaryEnergy);
+    current.shortTerm = toLoudness(shortTermEnergy);
+
+    if (numSteps >= momentarySteps)
+    {
+        current.maxMomentary = juce::jmax(current.maxMomentary, current.momentary);
+
+        //every step ends a 400 ms block, so blocks overlap by 75%
+        if (current.momentary > histogramMin)
+        {
+            auto bin = juce::jlimit(0, numHistogramBins - 1, static_cast<int>((current.momentary - histogramMin) / histogramStep));
+            ++binCounts[static_cast<size_t>(bin)];
+            binEnergies[static_cast<size_t>(bin)] += momentaryEnergy;
+
+            ++gatedCount;
+            gatedEnergy += momentaryEnergy;
+        }
+
+        current.integrated = computeIntegrated();
+    }
+
+    if (numSteps >= shortTermSteps)
+        current.maxShortTerm = juce::jmax(current.maxShortTerm, current.shortTerm);
+
+    current.truePeak = juce::jmax(current.truePeak, juce::Decibels::gainToDecibels(getPeakGain(), minLoudness));
+
+    published.getWriteBuffer() = current;
+    published.publish();
+}
+
+void LoudnessMeter::finish() noexcept
+{
+    if (stepPosition == 0)
+        return;
+
+    current.truePeak = juce::jmax(current.truePeak, juce::Decibels::gainToDecibels(getPeakGain(), minLoudness));
+
+    published.getWriteBuffer() = current;
+    published.publish();
+}
+
+float LoudnessMeter::getPeakGain() const noexcept
+{
+    constexpr auto W = Register::SIMDNumElements;
+    alignas(Register) float laneValues[W];
+
+    //the peaks are never cleared between steps, only by reset()
+    auto peakGain = 0.f;
+
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+        groups[g].peak.copyToRawArray(laneValues);
+        for (size_t l = 0; l < W; ++l)
+        {
+            peakGain = juce::jmax(peakGain, laneValues[l]);
+        }
+    }
+
+    return peakGain;
+}
+
+float LoudnessMeter::computeIntegrated() const noexcept
+{
+    if (gatedCount == 0)
+        return minLoudness;
+
+    //the relative gate, from every block above the absolute one
+    auto relativeGate = toLoudness(gatedEnergy / static_cast<double>(gatedCount)) - 10.f;
+    auto firstBin = juce::jlimit(0, numHistogramBins, static_cast<int>(std::ceil((relativeGate - histogramMin) / histogramStep)));
+
+    juce::uint64 count = 0;
+    auto energy = 0.0;
+
+    for (auto bin = static_cast<size_t>(firstBin); bin < binCounts.size(); ++bin)
+    {
+        count += binCounts[bin];
+        energy += binEnergies[bin];
+    }
+
+    return count > 0 ? toLoudness(energy / static_cast<double>(count)) : minLoudness;
+}
+
+float LoudnessMeter::toLoudness(double meanSquare) noexcept
+{
+    if (meanSquare <= 0.0)
+        return minLoudness;
+
+    return juce::jmax(minLoudness, static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare)));
+}
+
+LoudnessMeter::Readings LoudnessMeter::getReadings() noexcept
+{
+    published.acquire();
+    return published.getReadBuffer();
+}
+
+template void LoudnessMeter::process<float>(const juce::dsp::AudioBlock<const float>&) noexcept;
+template void LoudnessMeter::process<double>(const juce::dsp::AudioBlock<const double>&) noexcept;
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 18 Oct 2026 11:02:26pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TripleBuffer.h"
+
+/*
+ ITU-R BS.1770-4 / EBU R128 loudness and true-peak meter.
+
+ Each channel goes through the K-weighting pre-filter (a high shelf, then
+ the RLB high-pass). Its mean square is summed per 100 ms step and
+ weighted per channel; the LFE is left out and the side surrounds count
+ 1.41 times. The last 4 steps give the momentary loudness and the last
+ 30 the short-term loudness. Every step that completes a 400 ms block
+ adds it to a histogram of 0.1 LU bins, and the integrated loudness is
+ gated from that histogram (absolute gate at -70 LUFS, relative gate
+ 10 LU below), so it runs for hours in fixed memory.
+
+ True peak is the largest magnitude after 4x oversampling with the
+ 12 tap per phase interpolator of BS.1770-4 Annex 2.
+
+ Like the crossover, channels are packed into the lanes of a
+ juce::dsp::SIMDRegister, so both filters and the interpolator run once
+ per frame for up to a register's worth of channels. The meter runs in
+ float whatever the processor's sample type.
+
+ The readings are published through a TripleBuffer once per step, for
+ one reader thread. finish() publishes the true peak of a step that's cut
+ short, e.g. at the end of a file.
+ */
+class LoudnessMeter
+{
+public:
+    using Register = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int maxNumChannels = 16;
+
+    //what a reading shows while there's nothing to measure
+    static constexpr float minLoudness = -100.f;
+
+    struct Readings
+    {
+        float momentary = minLoudness;      //LUFS over the last 400 ms
+        float shortTerm = minLoudness;      //LUFS over the last 3 s
+        float integrated = minLoudness;     //gated LUFS since the last reset
+        float maxMomentary = minLoudness;
+        float maxShortTerm = minLoudness;
+        float truePeak = minLoudness;       //dBTP since the last reset
+    };
+
+    //call while not processing. also resets
+    void prepare(double sampleRate, int numChannels);
+
+    //restarts every reading. call while not processing, or use requestReset()
+    void reset();
+
+    //any thread. the audio thread resets the meter before its next block
+    void requestReset() noexcept { resetRequested.store(true); }
+
+    //the weight of each channel's energy, e.g. 0 for an LFE. 1 for every channel by default
+    void setChannelWeights(const std::array<float, maxNumChannels>& weights) noexcept;
+
+    template <typename SampleType>
+    void process(const juce::dsp::AudioBlock<const SampleType>& block) noexcept;
+
+    //on the thread that calls process(), after the last block. the loudness readings stay
+    //at the last whole step, since BS.1770's blocks are made of whole steps
+    void finish() noexcept;
+
+    //reader side: the readings as of the last completed step
+    Readings getReadings() noexcept;
+private:
+    struct Coefficients
+    {
+        float b0, b1, b2, a1, a2;
+    };
+
+    //transposed direct form II, one lane per channel
+    struct SectionState
+    {
+        Register s1, s2;
+    };
+
+    static constexpr size_t tileSize = 64;
+    static constexpr int numPhases = 4;
+    static constexpr int numTaps = 12;
+
+    static constexpr int momentarySteps = 4;
+    static constexpr int shortTermSteps = 30;
+
+    static constexpr float histogramMin = -70.f;
+    static constexpr float histogramStep = 0.1f;
+    static constexpr int numHistogramBins = 800;
+
+    struct Group
+    {
+        SectionState shelf, highpass;
+
+        //the last numTaps inputs, written twice so a window of them is always contiguous
+        std::array<Register, 2 * numTaps> history;
+
+        Register energy, peak;
+    };
+
+    double sampleRate = 48000.0;
+    int numChannels = 0;
+    size_t numGroups = 0;
+
+    Coefficients shelf{}, highpass{};
+    std::array<float, maxNumChannels> channelWeights;
+
+    std::array<Group, (maxNumChannels + Register::SIMDNumElements - 1) / Register::SIMDNumElements> groups;
+    int historyIndex = 0;
+
+    alignas(Register) float tile[tileSize * Register::SIMDNumElements];
+
+    int stepSamples = 4800;
+    int stepPosition = 0;
+
+    //weighted energy of each of the last shortTermSteps steps, oldest overwritten first
+    std::array<double, shortTermSteps> stepEnergies{};
+    int stepIndex = 0;
+    juce::int64 numSteps = 0;
+
+    //every 400 ms block above the absolute gate, binned by loudness
+    std::array<juce::uint32, numHistogramBins> binCounts{};
+    std::array<double, numHistogramBins> binEnergies{};
+    juce::uint64 gatedCount = 0;
+    double gatedEnergy = 0.0;
+
+    Readings current;
+    std::atomic<bool> resetRequested{ false };
+    TripleBuffer<Readings> published;
+
+    static float toLoudness(double meanSquare) noexcept;
+
+    void processTile(Group& group, size_t numFrames) noexcept;
+    void endStep() noexcept;
+    float getPeakGain() const noexcept;
+    float computeIntegrated() const noexcept;
+};
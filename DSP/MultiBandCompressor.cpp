@@ -0,0 +1,568 @@
+/*
+  ==============================================================================
+
+    MultiBandCompressor.cpp
+    Created: 18 Oct 2026 3:26:54pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include "MultiBandCompressor.h"
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::prepare(const juce::dsp::ProcessSpec& spec, int newNumBands)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(newNumBands > 0 && newNumBands <= maxNumBands);
+    jassert(spec.numChannels > 0 && static_cast<int>(spec.numChannels) <= maxNumChannels);
+
+    sampleRate = spec.sampleRate;
+    numBands = juce::jlimit(1, maxNumBands, newNumBands);
+    numChannels = juce::jlimit(1, maxNumChannels, static_cast<int>(spec.numChannels));
+
+    maxBlockSize = static_cast<size_t>(spec.maximumBlockSize);
+
+    envelopes.resize(static_cast<size_t>(numBands * numChannels));
+    inputEnergies.resize(envelopes.size());
+    outputEnergies.resize(envelopes.size());
+
+    //allocated whether or not anything is linked, so links can change on the audio thread
+    linkedLevels.resize(envelopes.size() * maxBlockSize);
+
+    //a few spare samples, for a lookahead rounded at the host rate and then scaled up to an oversampled one
+    maxLookaheadSamples = getMaxLookaheadSamples(sampleRate);
+    lookaheadCapacity = maxLookaheadSamples;
+    lookaheadSamples = juce::jmin(lookaheadSamples, maxLookaheadSamples);
+
+    auto delaySize = static_cast<size_t>(juce::nextPowerOfTwo(maxLookaheadSamples + 1));
+    delayIndexMask = static_cast<juce::uint32>(delaySize - 1);
+
+    lookaheads.resize(envelopes.size());
+    for (auto& lookahead : lookaheads)
+    {
+        lookahead.delay.resize(delaySize);
+        lookahead.peak.prepare(maxLookaheadSamples + 1);
+        lookahead.peak.setWindowLength(lookaheadSamples + 1);
+    }
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        updateBand(band);
+    }
+
+    reset();
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::reset()
+{
+    std::fill(envelopes.begin(), envelopes.end(), static_cast<SampleType>(0));
+    std::fill(inputEnergies.begin(), inputEnergies.end(), static_cast<SampleType>(0));
+    std::fill(outputEnergies.begin(), outputEnergies.end(), static_cast<SampleType>(0));
+    meteredSamples.fill(0);
+    meteredChannels.fill(0);
+
+    for (auto& lookahead : lookaheads)
+    {
+        resetLookahead(lookahead);
+    }
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::takeEnvelopes(const MultiBandCompressor& source, juce::uint32 bandMask) noexcept
+{
+    jassert(source.numBands == numBands && source.numChannels == numChannels);
+
+    //an envelope is a level, which means the same at any rate
+    for (int band = 0; band < numBands; ++band)
+    {
+        if ((bandMask & (1u << band)) == 0)
+            continue;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto lane = static_cast<size_t>(band * numChannels + channel);
+            envelopes[lane] = source.envelopes[lane];
+            resetLookahead(lookaheads[lane]);
+        }
+    }
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::setSampleRate(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0);
+    jassert(getMaxLookaheadSamples(newSampleRate) <= lookaheadCapacity);
+
+    sampleRate = newSampleRate;
+    maxLookaheadSamples = juce::jmin(getMaxLookaheadSamples(sampleRate), lookaheadCapacity);
+    lookaheadSamples = juce::jmin(lookaheadSamples, maxLookaheadSamples);
+
+    for (auto& lookahead : lookaheads)
+    {
+        lookahead.peak.setWindowLength(lookaheadSamples + 1);
+    }
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        updateBand(band);
+    }
+
+    //the delays hold audio at the old rate, and the envelopes start over along with them
+    reset();
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::setLookaheadSamples(int numSamples)
+{
+    jassert(numSamples >= 0 && numSamples <= maxLookaheadSamples);
+    numSamples = juce::jlimit(0, maxLookaheadSamples, numSamples);
+
+    //automation keeps landing on the same rounded count, and that mustn't restart the delays
+    if (numSamples == lookaheadSamples)
+        return;
+
+    lookaheadSamples = numSamples;
+
+    //the peak window covers everything in the delay line plus the sample going in
+    for (auto& lookahead : lookaheads)
+    {
+        lookahead.peak.setWindowLength(lookaheadSamples + 1);
+        resetLookahead(lookahead);
+    }
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::setChannelLinks(const std::array<juce::uint32, maxNumChannels>& links) noexcept
+{
+    channelLinks = links;
+    anyLinked = false;
+
+    for (size_t c = 0; c < channelLinks.size(); ++c)
+    {
+        anyLinked = anyLinked || (channelLinks[c] & ~(1u << c)) != 0;
+    }
+}
+
+template <typename SampleType>
+juce::uint32 MultiBandCompressor<SampleType>::getLinkedChannels(int channel, int bandChannels) const noexcept
+{
+    //always includes the channel itself, never a channel the band doesn't have
+    auto links = channelLinks[static_cast<size_t>(channel)] | (1u << channel);
+    return links & ((1u << bandChannels) - 1u);
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::fillLinkedLevels(const juce::dsp::AudioBlock<SampleType>* bands,
+                                                       const juce::dsp::AudioBlock<const SampleType>* keys,
+                                                       juce::uint32 bandMask) noexcept
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        if ((bandMask & (1u << band)) == 0)
+            continue;
+
+        const auto& block = bands[band];
+        auto bandChannels = juce::jmin(numChannels, static_cast<int>(block.getNumChannels()));
+        auto numSamples = block.getNumSamples();
+        jassert(numSamples <= maxBlockSize);
+
+        for (int channel = 0; channel < bandChannels; ++channel)
+        {
+            //a group's row belongs to its lowest channel. a channel on its own has none
+            auto links = getLinkedChannels(channel, bandChannels);
+            if (links == (1u << channel) || (links & ((1u << channel) - 1u)) != 0)
+                continue;
+
+            auto* level = linkedLevels.data() + static_cast<size_t>(band * numChannels + channel) * maxBlockSize;
+            std::fill(level, level + numSamples, static_cast<SampleType>(0));
+
+            for (int member = channel; member < bandChannels; ++member)
+            {
+                if ((links & (1u << member)) == 0)
+                    continue;
+
+                //a mono key feeds every channel, as in processLanes()
+                const auto* src = keys != nullptr ? keys[band].getChannelPointer(juce::jmin(static_cast<size_t>(member), keys[band].getNumChannels() - 1))
+                                                  : block.getChannelPointer(static_cast<size_t>(member));
+
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    level[i] = juce::jmax(level[i], std::abs(src[i]));
+                }
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::resetLookahead(Lookahead& lookahead) noexcept
+{
+    std::fill(lookahead.delay.begin(), lookahead.delay.end(), static_cast<SampleType>(0));
+    lookahead.writePosition = 0;
+    lookahead.peak.reset();
+    lookahead.peakIsCurrent = true;
+}
+
+template <typename SampleType>
+SampleType MultiBandCompressor<SampleType>::pushDelay(Lookahead& lookahead, SampleType input) noexcept
+{
+    lookahead.delay[lookahead.writePosition & delayIndexMask] = input;
+    auto output = lookahead.delay[(lookahead.writePosition - static_cast<juce::uint32>(lookaheadSamples)) & delayIndexMask];
+    ++lookahead.writePosition;
+    return output;
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::setAttack(int band, SampleType attackMs)
+{
+    settings[static_cast<size_t>(band)].attackMs = attackMs;
+    updateBand(band);
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::setRelease(int band, SampleType releaseMs)
+{
+    settings[static_cast<size_t>(band)].releaseMs = releaseMs;
+    updateBand(band);
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::setThreshold(int band, SampleType thresholdDb)
+{
+    settings[static_cast<size_t>(band)].thresholdDb = thresholdDb;
+    updateBand(band);
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::setRatio(int band, SampleType ratio)
+{
+    jassert(ratio >= static_cast<SampleType>(1.0));
+
+    settings[static_cast<size_t>(band)].ratio = ratio;
+    updateBand(band);
+}
+
+template <typename SampleType>
+SampleType MultiBandCompressor<SampleType>::calculateLimitedCte(SampleType timeMs) const
+{
+    //as in juce::dsp::BallisticsFilter
+    auto expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / sampleRate;
+    return timeMs < static_cast<SampleType>(1.0e-3) ? static_cast<SampleType>(0)
+                                                    : static_cast<SampleType>(std::exp(expFactor / timeMs));
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::updateBand(int band)
+{
+    jassert(juce::isPositiveAndBelow(band, maxNumBands));
+
+    //as in juce::dsp::Compressor::update()
+    auto& s = settings[static_cast<size_t>(band)];
+    s.threshold = juce::Decibels::decibelsToGain(s.thresholdDb, static_cast<SampleType>(-200.0));
+    s.thresholdInverse = static_cast<SampleType>(1.0) / s.threshold;
+    s.exponent = static_cast<SampleType>(1.0) / s.ratio - static_cast<SampleType>(1.0);
+
+    s.cteAT = calculateLimitedCte(s.attackMs);
+    s.cteRL = calculateLimitedCte(s.releaseMs);
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::process(juce::dsp::AudioBlock<SampleType>* bands,
+                                              juce::uint32 bandMask,
+                                              juce::uint32 delayMask,
+                                              const juce::dsp::AudioBlock<const SampleType>* keys) noexcept
+{
+    //the lane table lives on the stack so disjoint band sets can be processed concurrently
+    std::array<Lane, maxNumBands * maxNumChannels> lanes;
+    size_t numLanes = 0;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        if ((bandMask & (1u << band)) == 0)
+            continue;
+
+        auto bandChannels = juce::jmin(numChannels, static_cast<int>(bands[band].getNumChannels()));
+        for (int channel = 0; channel < bandChannels; ++channel)
+        {
+            lanes[numLanes++] = { band, channel };
+        }
+
+        meteredSamples[static_cast<size_t>(band)] = bands[band].getNumSamples();
+        meteredChannels[static_cast<size_t>(band)] = bandChannels;
+    }
+
+    //before any lane is compressed, while every channel of a group still holds its input
+    if (anyLinked)
+        fillLinkedLevels(bands, keys, bandMask);
+
+    constexpr auto W = Register::SIMDNumElements;
+
+    for (size_t first = 0; first < numLanes; first += W)
+    {
+        processLanes(bands, keys, lanes.data() + first, juce::jmin(W, numLanes - first));
+    }
+
+    if (lookaheadSamples == 0)
+        return;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        if ((delayMask & ~bandMask & (1u << band)) == 0)
+            continue;
+
+        auto bandChannels = juce::jmin(numChannels, static_cast<int>(bands[band].getNumChannels()));
+        for (int channel = 0; channel < bandChannels; ++channel)
+        {
+            delayLane(bands, { band, channel });
+        }
+    }
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::delayLane(juce::dsp::AudioBlock<SampleType>* bands, const Lane& lane) noexcept
+{
+    auto& lookahead = lookaheads[static_cast<size_t>(lane.band * numChannels + lane.channel)];
+    auto* data = bands[lane.band].getChannelPointer(static_cast<size_t>(lane.channel));
+
+    for (size_t i = 0; i < bands[lane.band].getNumSamples(); ++i)
+    {
+        data[i] = pushDelay(lookahead, data[i]);
+    }
+
+    lookahead.peakIsCurrent = false;
+}
+
+template <typename SampleType>
+void MultiBandCompressor<SampleType>::processLanes(juce::dsp::AudioBlock<SampleType>* bands,
+                                                   const juce::dsp::AudioBlock<const SampleType>* keys,
+                                                   const Lane* lanes,
+                                                   size_t numLanes) noexcept
+{
+    constexpr auto W = Register::SIMDNumElements;
+
+    alignas(Register) SampleType tile[tileSize * W];
+    alignas(Register) SampleType peaks[tileSize * W];
+    alignas(Register) SampleType laneValues[W];
+    SampleType thresholds[W], thresholdInverses[W], exponents[W];
+
+    //spare lanes get silence and a threshold they never reach
+    auto loadLanes = [&](auto getValue, SampleType spareValue)
+    {
+        for (size_t l = 0; l < W; ++l)
+        {
+            laneValues[l] = l < numLanes ? getValue(lanes[l]) : spareValue;
+        }
+        return Register::fromRawArray(laneValues);
+    };
+
+    auto getSettings = [this](const Lane& lane) -> const BandSettings& { return settings[static_cast<size_t>(lane.band)]; };
+    auto getEnvelope = [this](const Lane& lane) -> SampleType& { return envelopes[static_cast<size_t>(lane.band * numChannels + lane.channel)]; };
+    auto getLookahead = [this](const Lane& lane) -> Lookahead& { return lookaheads[static_cast<size_t>(lane.band * numChannels + lane.channel)]; };
+
+    //a key channel per lane. a mono key feeds every channel of its band
+    auto getKey = [keys](const Lane& lane)
+    {
+        const auto& key = keys[lane.band];
+        jassert(key.getNumChannels() > 0);
+        return key.getChannelPointer(juce::jmin(static_cast<size_t>(lane.channel), key.getNumChannels() - 1));
+    };
+
+    const auto useLookahead = lookaheadSamples > 0;
+    const auto useKeys = keys != nullptr;
+
+    //the row a linked lane follows, see fillLinkedLevels()
+    const SampleType* linkedRows[W]{};
+    auto useLinks = false;
+
+    for (size_t l = 0; l < numLanes && anyLinked; ++l)
+    {
+        const auto& lane = lanes[l];
+        auto links = getLinkedChannels(lane.channel, juce::jmin(numChannels, static_cast<int>(bands[lane.band].getNumChannels())));
+        if (links == (1u << lane.channel))
+            continue;
+
+        auto first = 0;
+        while ((links & (1u << first)) == 0)
+            ++first;
+
+        linkedRows[l] = linkedLevels.data() + static_cast<size_t>(lane.band * numChannels + first) * maxBlockSize;
+        useLinks = true;
+    }
+
+    const auto usePeaks = useLookahead || useKeys || useLinks;
+
+    if (useLookahead)
+    {
+        //a lane that was only delayed refills its peak window from what the delay line holds.
+        //the key or group level that went with it is gone, so those lanes start from an empty window instead
+        for (size_t l = 0; l < numLanes; ++l)
+        {
+            auto& lookahead = getLookahead(lanes[l]);
+            if (lookahead.peakIsCurrent)
+                continue;
+
+            lookahead.peak.reset();
+            for (auto i = static_cast<juce::uint32>(useKeys || linkedRows[l] != nullptr ? 0 : lookaheadSamples); i > 0; --i)
+            {
+                lookahead.peak.process(std::abs(lookahead.delay[(lookahead.writePosition - i) & delayIndexMask]));
+            }
+
+            lookahead.peakIsCurrent = true;
+        }
+    }
+
+    const auto cteAT = loadLanes([&](const Lane& l) { return getSettings(l).cteAT; }, 0);
+    const auto cteRL = loadLanes([&](const Lane& l) { return getSettings(l).cteRL; }, 0);
+    const auto threshold = loadLanes([&](const Lane& l) { return getSettings(l).threshold; }, 1);
+    auto envelope = loadLanes([&](const Lane& l) { return getEnvelope(l); }, 0);
+
+    for (size_t l = 0; l < W; ++l)
+    {
+        thresholds[l] = l < numLanes ? getSettings(lanes[l]).threshold : static_cast<SampleType>(1);
+        thresholdInverses[l] = l < numLanes ? getSettings(lanes[l]).thresholdInverse : static_cast<SampleType>(1);
+        exponents[l] = l < numLanes ? getSettings(lanes[l]).exponent : static_cast<SampleType>(0);
+    }
+
+    const auto zero = Register::expand(static_cast<SampleType>(0));
+    const auto one = Register::expand(static_cast<SampleType>(1));
+    const auto numSamples = bands[lanes[0].band].getNumSamples();
+
+    auto inputEnergy = zero, outputEnergy = zero;
+
+    for (size_t start = 0; start < numSamples; start += tileSize)
+    {
+        const auto numFrames = juce::jmin(tileSize, numSamples - start);
+
+        if (numLanes < W)
+        {
+            std::fill(tile, tile + numFrames * W, static_cast<SampleType>(0));
+            std::fill(peaks, peaks + numFrames * W, static_cast<SampleType>(0));
+        }
+
+        for (size_t l = 0; l < numLanes; ++l)
+        {
+            auto* src = bands[lanes[l].band].getChannelPointer(static_cast<size_t>(lanes[l].channel)) + start;
+            auto* key = useKeys ? getKey(lanes[l]) + start : src;
+            auto* linked = linkedRows[l] != nullptr ? linkedRows[l] + start : nullptr;
+
+            //what the detector follows: the group's level if the lane is linked, its key's (or its own) otherwise
+            auto getLevel = [key, linked](size_t t) { return linked != nullptr ? linked[t] : std::abs(key[t]); };
+
+            if (useLookahead)
+            {
+                //the envelope sees the peak of what's in the delay line, the gain lands on what comes out of it
+                auto& lookahead = getLookahead(lanes[l]);
+                for (size_t t = 0; t < numFrames; ++t)
+                {
+                    tile[t * W + l] = pushDelay(lookahead, src[t]);
+                    peaks[t * W + l] = lookahead.peak.process(getLevel(t));
+                }
+            }
+            else
+            {
+                for (size_t t = 0; t < numFrames; ++t)
+                {
+                    tile[t * W + l] = src[t];
+                }
+
+                if (usePeaks)
+                {
+                    for (size_t t = 0; t < numFrames; ++t)
+                    {
+                        peaks[t * W + l] = getLevel(t);
+                    }
+                }
+            }
+        }
+
+        for (size_t t = 0; t < numFrames; ++t)
+        {
+            auto x = Register::fromRawArray(tile + t * W);
+            auto xx = x * x;
+            inputEnergy += xx;
+
+            //peak ballistics, as in juce::dsp::BallisticsFilter::processSample()
+            auto rectified = usePeaks ? Register::fromRawArray(peaks + t * W) : Register::max(x, zero - x);
+            auto attacking = one & Register::greaterThan(rectified, envelope);
+            auto cte = cteAT * attacking + cteRL * (one - attacking);
+            envelope = rectified + cte * (envelope - rectified);
+
+            //mask lanes are all ones or all zeros, so the sum is only zero if no lane is set
+            if (Register::greaterThanOrEqual(envelope, threshold).sum() == 0)
+            {
+                outputEnergy += xx;
+                continue;
+            }
+
+            //gain computer, as in juce::dsp::Compressor::processSample()
+            envelope.copyToRawArray(laneValues);
+            for (size_t l = 0; l < W; ++l)
+            {
+                auto env = laneValues[l];
+                laneValues[l] = env < thresholds[l] ? static_cast<SampleType>(1.0)
+                                                    : std::pow(env * thresholdInverses[l], exponents[l]);
+            }
+
+            auto y = x * Register::fromRawArray(laneValues);
+            outputEnergy += y * y;
+            y.copyToRawArray(tile + t * W);
+        }
+
+        for (size_t l = 0; l < numLanes; ++l)
+        {
+            auto* dst = bands[lanes[l].band].getChannelPointer(static_cast<size_t>(lanes[l].channel)) + start;
+            for (size_t t = 0; t < numFrames; ++t)
+            {
+                dst[t] = tile[t * W + l];
+            }
+        }
+    }
+
+    envelope.copyToRawArray(laneValues);
+    for (size_t l = 0; l < numLanes; ++l)
+    {
+        getEnvelope(lanes[l]) = laneValues[l];
+    }
+
+    inputEnergy.copyToRawArray(laneValues);
+    for (size_t l = 0; l < numLanes; ++l)
+    {
+        inputEnergies[static_cast<size_t>(lanes[l].band * numChannels + lanes[l].channel)] = laneValues[l];
+    }
+
+    outputEnergy.copyToRawArray(laneValues);
+    for (size_t l = 0; l < numLanes; ++l)
+    {
+        outputEnergies[static_cast<size_t>(lanes[l].band * numChannels + lanes[l].channel)] = laneValues[l];
+    }
+}
+
+template <typename SampleType>
+typename MultiBandCompressor<SampleType>::BandLevels MultiBandCompressor<SampleType>::getLevels(int band) const noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, numBands));
+
+    BandLevels levels;
+    auto numSamples = meteredSamples[static_cast<size_t>(band)];
+    auto bandChannels = meteredChannels[static_cast<size_t>(band)];
+
+    if (numSamples == 0 || bandChannels == 0)
+        return levels;
+
+    //the mean of the channels' RMS levels, as AudioBuffer::getRMSLevel() per channel would give
+    for (int channel = 0; channel < bandChannels; ++channel)
+    {
+        auto lane = static_cast<size_t>(band * numChannels + channel);
+        levels.input += static_cast<float>(std::sqrt(inputEnergies[lane] / static_cast<SampleType>(numSamples)));
+        levels.output += static_cast<float>(std::sqrt(outputEnergies[lane] / static_cast<SampleType>(numSamples)));
+    }
+
+    levels.input /= static_cast<float>(bandChannels);
+    levels.output /= static_cast<float>(bandChannels);
+    return levels;
+}
+
+template class MultiBandCompressor<float>;
+template class MultiBandCompressor<double>;
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    MultiBandCompressor.h
+    Created: 18 Oct 2026 3:26:54pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SlidingWindowMaximum.h"
+
+/*
+ Dynamics for every band in one loop.
+
+ Behaves like one juce::dsp::Compressor per band (peak ballistics filter,
+ hard knee, same attack/release/threshold/ratio maths), but treats every
+ (band, channel) pair as a lane of a juce::dsp::SIMDRegister, so the
+ envelope follower, gain computer and gain application run once per frame
+ for all bands instead of once per band per channel.
+
+ The pow() of the gain computer is only evaluated for lanes above their
+ threshold; frames where every lane is below threshold cost one compare.
+
+ With lookahead, every lane's audio goes through a delay line and the
+ envelope follows the peak of the window the delay holds (a
+ SlidingWindowMaximum), so gain reduction is already there when a peak
+ comes out of the delay.
+
+ An optional key per band (an external sidechain split into the same
+ bands) drives the envelope instead of the band's own audio.
+
+ The same loop sums the squares of every lane before and after its gain,
+ so the band meters come out of process() without another pass over
+ the bands.
+
+ Channels can be linked in groups (e.g. the fronts, surrounds and heights
+ of a 7.1.4 bus). Every channel of a group follows the loudest of them, so
+ a peak in one channel doesn't pull the image towards the others. The
+ group's level is taken from the band before any of its lanes are
+ compressed, since the lanes of one group can land in different registers.
+ */
+template <typename SampleType>
+class MultiBandCompressor
+{
+public:
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int maxNumBands = 8;
+    static constexpr int maxNumChannels = 16;
+
+    //at whatever rate the engine is prepared for
+    static constexpr double maxLookaheadMs = 10.0;
+
+    void prepare(const juce::dsp::ProcessSpec& spec, int numBands);
+    void reset();
+
+    //for bands moving here from 'source', another engine running the same bands at another rate.
+    //the bands in 'bandMask' pick up its envelopes, with their lookahead delays cleared. safe on the audio thread
+    void takeEnvelopes(const MultiBandCompressor& source, juce::uint32 bandMask) noexcept;
+
+    //a new rate for the ballistics and the lookahead limit, without reallocating, so it's safe
+    //on the audio thread. the rate can be at most the one prepare() sized the delay lines for
+    void setSampleRate(double newSampleRate) noexcept;
+
+    void setAttack(int band, SampleType attackMs);
+    void setRelease(int band, SampleType releaseMs);
+    void setThreshold(int band, SampleType thresholdDb);
+    void setRatio(int band, SampleType ratio);
+
+    //0 turns lookahead off. changing it restarts the delay lines from silence, setting the same count again doesn't
+    void setLookaheadSamples(int numSamples);
+    int getLookaheadSamples() const { return lookaheadSamples; }
+    int getMaxLookaheadSamples() const { return maxLookaheadSamples; }
+
+    /*
+     links[c] has a bit set for every channel that shares channel c's detector.
+     every channel of a group should have the same mask. channels left at 0 are
+     only linked to themselves, which is the default. survives prepare()
+     */
+    void setChannelLinks(const std::array<juce::uint32, maxNumChannels>& links) noexcept;
+
+    /*
+     compresses, in place, every band whose bit is set in 'bandMask'.
+     bands left out keep their envelope untouched, which is what a
+     bypassed juce::dsp::Compressor does.
+
+     with lookahead on, bands in 'delayMask' but not in 'bandMask' are only
+     delayed, so they still line up with the compressed ones.
+
+     if 'keys' isn't null, keys[band] drives the envelope of 'band'. it needs
+     as many samples as the band and at least one channel.
+     */
+    void process(juce::dsp::AudioBlock<SampleType>* bands,
+                 juce::uint32 bandMask,
+                 juce::uint32 delayMask = 0,
+                 const juce::dsp::AudioBlock<const SampleType>* keys = nullptr) noexcept;
+
+    //linear RMS levels, each channel's RMS over the block averaged over the band's channels
+    struct BandLevels
+    {
+        float input = 0.f;
+        float output = 0.f;
+    };
+
+    //the levels of 'band' over the last process() that compressed it. with lookahead both are
+    //taken from the delayed audio, so they cover the same samples
+    BandLevels getLevels(int band) const noexcept;
+private:
+    struct Lane
+    {
+        int band;
+        int channel;
+    };
+
+    struct BandSettings
+    {
+        SampleType attackMs = 1, releaseMs = 100;
+        SampleType thresholdDb = 0, ratio = 1;
+
+        SampleType cteAT = 0, cteRL = 0;
+        SampleType threshold = 1, thresholdInverse = 1, exponent = 0;
+    };
+
+    //one per (band, channel), like the envelopes
+    struct Lookahead
+    {
+        std::vector<SampleType> delay;
+        juce::uint32 writePosition = 0;
+        SlidingWindowMaximum<SampleType> peak;
+
+        //false once the lane has only been delayed, so the peak window missed what went through
+        bool peakIsCurrent = true;
+    };
+
+    static constexpr size_t tileSize = 64;
+
+    double sampleRate = 44100.0;
+    int numBands = 0;
+    int numChannels = 0;
+    size_t maxBlockSize = 0;
+
+    std::array<BandSettings, maxNumBands> settings;
+
+    //one envelope per (band, channel), band major
+    std::vector<SampleType> envelopes;
+
+    //sums of squares from the last block, like the envelopes
+    std::vector<SampleType> inputEnergies, outputEnergies;
+    std::array<size_t, maxNumBands> meteredSamples{};
+    std::array<int, maxNumBands> meteredChannels{};
+
+    std::vector<Lookahead> lookaheads;
+    int lookaheadSamples = 0;
+    int maxLookaheadSamples = 0;
+    int lookaheadCapacity = 0;
+    juce::uint32 delayIndexMask = 0;
+
+    std::array<juce::uint32, maxNumChannels> channelLinks{};
+    bool anyLinked = false;
+
+    //one row of maxBlockSize per (band, channel), band major. only the row of a group's
+    //lowest channel is filled, with the level every channel of the group follows
+    std::vector<SampleType> linkedLevels;
+
+    juce::uint32 getLinkedChannels(int channel, int bandChannels) const noexcept;
+    void fillLinkedLevels(const juce::dsp::AudioBlock<SampleType>* bands,
+                          const juce::dsp::AudioBlock<const SampleType>* keys,
+                          juce::uint32 bandMask) noexcept;
+
+    static int getMaxLookaheadSamples(double rate) { return static_cast<int>(std::ceil(maxLookaheadMs * rate / 1000.0)) + 3; }
+
+    SampleType calculateLimitedCte(SampleType timeMs) const;
+    void updateBand(int band);
+
+    void resetLookahead(Lookahead& lookahead) noexcept;
+    SampleType pushDelay(Lookahead& lookahead, SampleType input) noexcept;
+    void delayLane(juce::dsp::AudioBlock<SampleType>* bands, const Lane& lane) noexcept;
+
+    void processLanes(juce::dsp::AudioBlock<SampleType>* bands,
+                      const juce::dsp::AudioBlock<const SampleType>* keys,
+                      const Lane* lanes,
+                      size_t numLanes) noexcept;
+};
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.cpp
+    Created: 18 Oct 2026 5:02:31pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+
+void ParameterSnapshot::attach(juce::AudioProcessorValueTreeState& apvts)
+{
+    const auto& params = Params::GetParams();
+    jassert(params.size() == numParams);
+
+    for (const auto& [name, id] : params)
+    {
+        sources[static_cast<size_t>(name)] = apvts.getRawParameterValue(id);
+        jassert(sources[static_cast<size_t>(name)] != nullptr);
+    }
+
+    markAllDirty();
+}
+
+bool ParameterSnapshot::update() noexcept
+{
+    dirty.reset();
+
+    for (size_t i = 0; i < numParams; ++i)
+    {
+        auto value = sources[i]->load(std::memory_order_relaxed);
+        if (forceUpdate || value != values[i])
+        {
+            values[i] = value;
+            dirty.set(i);
+        }
+    }
+
+    forceUpdate = false;
+    return dirty.any();
+}
+
+float ParameterSnapshot::getRatio(Params::Names name) const noexcept
+{
+    const auto& ratios = Params::Ratios;
+    return ratios[static_cast<size_t>(juce::jlimit(0, static_cast<int>(ratios.size()) - 1, getIndex(name)))];
+}
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+    Created: 18 Oct 2026 5:02:31pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <bitset>
+#include "Params.h"
+
+/*
+ One consistent copy of every parameter value per block.
+
+ update() reads each parameter's raw atomic value once and sets a dirty bit
+ for every value that differs from the previous block, so the processor only
+ recomputes coefficients for what actually changed. Choice parameters are
+ read as their index, never as their choice name, so nothing on the audio
+ thread touches juce::String.
+ */
+struct ParameterSnapshot
+{
+    //message thread, once the parameters exist
+    void attach(juce::AudioProcessorValueTreeState& apvts);
+
+    //audio thread. returns true if any parameter changed since the last call
+    bool update() noexcept;
+
+    //the next update() reports every parameter as changed, e.g. after prepareToPlay()
+    void markAllDirty() noexcept { forceUpdate = true; }
+
+    bool isDirty(Params::Names name) const noexcept { return dirty[static_cast<size_t>(name)]; }
+
+    float get(Params::Names name) const noexcept { return values[static_cast<size_t>(name)]; }
+    bool getBool(Params::Names name) const noexcept { return get(name) >= 0.5f; }
+    int getIndex(Params::Names name) const noexcept { return juce::roundToInt(get(name)); }
+    float getRatio(Params::Names name) const noexcept;
+private:
+    static constexpr size_t numParams = static_cast<size_t>(Params::Names::NumParams);
+
+    std::array<std::atomic<float>*, numParams> sources{};
+    std::array<float, numParams> values{};
+    std::bitset<numParams> dirty;
+    bool forceUpdate = true;
+};
@@ -11,72 +11,107 @@
 #pragma once
 #include <JuceHeader.h>
 
+//number of bands the plugin is built with. the 3 band build keeps the original
+//Low/Mid/High parameter IDs, so existing sessions and presets still load
+#ifndef MBCOMP_NUM_BANDS
+ #define MBCOMP_NUM_BANDS 3
+#endif
+
 namespace Params {
+    constexpr int NumBands = MBCOMP_NUM_BANDS;
+    constexpr int NumCrossovers = NumBands - 1;
+
+    static_assert(NumBands >= 2 && NumBands <= 8, "MBCOMP_NUM_BANDS must be between 2 and 8");
+
+    /*
+     every per band parameter owns NumBands consecutive slots, lowest band
+     first, and the crossovers own NumCrossovers. use getBandParam() and
+     getCrossoverParam() to get the slot for one band or crossover.
+     */
     enum Names {
-        LowMidCrossoverFreq,
-        MidHighCrossoverFreq,
+        CrossoverFreq = 0,
+
+        Threshold = CrossoverFreq + NumCrossovers,
+        Attack = Threshold + NumBands,
+        Release = Attack + NumBands,
+        Ratio = Release + NumBands,
+        Bypassed = Ratio + NumBands,
+        Mute = Bypassed + NumBands,
+        Solo = Mute + NumBands,
 
-        LowThreshold,
-        MidThreshold,
-        HighThreshold,
+        GainIn = Solo + NumBands,
+        GainOut,
+        LinearPhase,
+        Oversampling,
+        Lookahead,
+        Sidechain,
+        ChannelLink,
 
-        LowAttack,
-        MidAttack,
-        HighAttack,
+        NumParams
+    };
 
-        LowRelease,
-        MidRelease,
-        HighRelease,
+    constexpr Names getBandParam(Names name, int band) { return static_cast<Names>(name + band); }
+    constexpr Names getCrossoverParam(int index) { return static_cast<Names>(CrossoverFreq + index); }
 
-        LowRatio,
-        MidRatio,
-        HighRatio,
+    //the ratio choices, in the order of the AudioParameterChoice index
+    inline constexpr std::array<float, 14> Ratios{ 1.f, 1.5f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 10.f, 15.f, 20.f, 50.f, 100.f };
 
-        LowBypassed,
-        MidBypassed,
-        HighBypassed,
+    //the oversampling choices, in the order of the AudioParameterChoice index. index n is 2^n times
+    inline const juce::StringArray OversamplingChoices{ "Off", "2x", "4x" };
 
-        LowMute,
-        MidMute,
-        HighMute,
+    //which channels share a detector: none, each group of the bus (fronts, surrounds, heights), or all of them
+    inline const juce::StringArray ChannelLinkChoices{ "Off", "Groups", "All" };
 
-        LowSolo,
-        MidSolo,
-        HighSolo,
+    inline juce::String getBandName(int band)
+    {
+        jassert(juce::isPositiveAndBelow(band, NumBands));
 
-        GainIn,
-        GainOut,
-    };
+        if (NumBands == 3)
+            return juce::StringArray{ "Low", "Mid", "High" }[band];
+
+        return juce::String(band + 1);
+    }
 
     inline const std::map<Names, juce::String>& GetParams() {
-        static std::map<Names, juce::String> params =
+        static std::map<Names, juce::String> params = []
         {
-            {LowMidCrossoverFreq, "Low-Mid Crossover Frequency"},
-            {MidHighCrossoverFreq, "Mid-High Crossover Frequency"},
-            {LowThreshold, "Threshold Low Band"},
-            {MidThreshold, "Threshold Mid Band"},
-            {HighThreshold, "Threshold High Band"},
-            {LowAttack, "Attack Low Band"},
-            {MidAttack, "Attack Mid Band"},
-            {HighAttack, "Attack High Band"},
-            {LowRelease, "Release Low Band"},
-            {MidRelease, "Release Mid Band"},
-            {HighRelease, "Release High Band"},
-            {LowRatio, "Ratio Low Band"},
-            {MidRatio, "Ratio Mid Band"},
-            {HighRatio, "Ratio High Band"},
-            {LowBypassed, "Bypassed Low Band"},
-            {MidBypassed, "Bypassed Mid Band"},
-            {HighBypassed, "Bypassed High Band"},
-            {LowMute, "Mute Low Band"},
-            {MidMute, "Mute Mid Band"},
-            {HighMute, "Mute High Band"},
-            {LowSolo, "Solo Low Band"},
-            {MidSolo, "Solo Mid Band"},
-            {HighSolo, "Solo High Band"},
-            {GainIn, "Gain In"},
-            {GainOut, "Gain Out"},
-        };
+            std::map<Names, juce::String> names;
+
+            for (int i = 0; i < NumCrossovers; ++i)
+            {
+                names[getCrossoverParam(i)] = getBandName(i) + "-" + getBandName(i + 1) + " Crossover Frequency";
+            }
+
+            const std::vector<std::pair<Names, juce::String>> bandParams
+            {
+                {Threshold, "Threshold"},
+                {Attack, "Attack"},
+                {Release, "Release"},
+                {Ratio, "Ratio"},
+                {Bypassed, "Bypassed"},
+                {Mute, "Mute"},
+                {Solo, "Solo"},
+            };
+
+            for (const auto& [name, prefix] : bandParams)
+            {
+                for (int band = 0; band < NumBands; ++band)
+                {
+                    names[getBandParam(name, band)] = NumBands == 3 ? prefix + " " + getBandName(band) + " Band"
+                                                                    : prefix + " Band " + getBandName(band);
+                }
+            }
+
+            names[GainIn] = "Gain In";
+            names[GainOut] = "Gain Out";
+            names[LinearPhase] = "Linear Phase";
+            names[Oversampling] = "Oversampling";
+            names[Lookahead] = "Lookahead";
+            names[Sidechain] = "Sidechain";
+            names[ChannelLink] = "Channel Link";
+
+            return names;
+        }();
 
         return params;
     }
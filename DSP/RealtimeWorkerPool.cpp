@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    RealtimeWorkerPool.cpp
+    Created: 18 Oct 2026 9:47:12pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include "RealtimeWorkerPool.h"
+
+RealtimeWorkerPool::Worker::Worker(RealtimeWorkerPool& owner) : juce::Thread("MBComp Band Worker"), pool(owner)
+{
+}
+
+void RealtimeWorkerPool::Worker::run()
+{
+    //the jobs are audio, so they get the same denormal handling as the audio thread
+    juce::ScopedNoDenormals noDenormals;
+    auto seen = getBatch(pool.cursor.load());
+
+    while (!threadShouldExit())
+    {
+        auto batch = getBatch(pool.cursor.load(std::memory_order_acquire));
+
+        for (int spin = 0; batch == seen && spin < spinCount; ++spin)
+        {
+            batch = getBatch(pool.cursor.load(std::memory_order_acquire));
+        }
+
+        if (batch == seen)
+        {
+            //run() checks 'sleeping' after publishing, and this checks the batch after setting it,
+            //so one of the two always sees the other and the wake up can't be missed
+            sleeping.store(true);
+            if (getBatch(pool.cursor.load()) == seen)
+                wake.wait(100);
+
+            sleeping.store(false);
+            continue;
+        }
+
+        seen = batch;
+        pool.runJobs(batch);
+    }
+}
+
+RealtimeWorkerPool::~RealtimeWorkerPool()
+{
+    setNumWorkers(0);
+}
+
+void RealtimeWorkerPool::setNumWorkers(int newNumWorkers)
+{
+    jassert(newNumWorkers >= 0 && newNumWorkers <= maxNumWorkers);
+    newNumWorkers = juce::jlimit(0, maxNumWorkers, newNumWorkers);
+
+    for (auto& worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->wake.signal();
+    }
+
+    for (auto& worker : workers)
+    {
+        worker->stopThread(1000);
+    }
+
+    workers.clear();
+
+    for (int i = 0; i < newNumWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>(*this));
+        startWorker(*workers.back());
+    }
+}
+
+void RealtimeWorkerPool::setBlockPeriod(int samplesPerBlock, double sampleRate)
+{
+    jassert(samplesPerBlock > 0 && sampleRate > 0);
+
+    if (samplesPerBlock == periodSamples && sampleRate == periodSampleRate)
+        return;
+
+    periodSamples = samplesPerBlock;
+    periodSampleRate = sampleRate;
+
+    //a thread's real-time options are only read when it starts
+    setNumWorkers(getNumWorkers());
+}
+
+void RealtimeWorkerPool::startWorker(Worker& worker) const
+{
+    //before the first setBlockPeriod() there's no period to give the scheduler yet
+    auto options = juce::Thread::RealtimeOptions{};
+    if (periodSamples > 0)
+        options = options.withApproximateAudioProcessingTime(periodSamples, periodSampleRate);
+
+    //hosts without the rights to real-time threads still get the highest normal priority
+    if (! worker.startRealtimeThread(options))
+        worker.startThread(juce::Thread::Priority::highest);
+}
+
+void RealtimeWorkerPool::run(int numJobs, JobFunction function, void* context) noexcept
+{
+    jassert(numJobs >= 0 && numJobs <= 0xffff);
+
+    if (numJobs <= 0)
+        return;
+
+    //without workers there is nothing to hand out
+    if (workers.empty())
+    {
+        for (int i = 0; i < numJobs; ++i)
+        {
+            function(context, i);
+        }
+        return;
+    }
+
+    jobFunction = function;
+    jobContext = context;
+    jobsRemaining.store(numJobs, std::memory_order_relaxed);
+
+    auto batch = getBatch(cursor.load(std::memory_order_relaxed)) + 1;
+    cursor.store((static_cast<juce::uint64>(batch) << 32) | (static_cast<juce::uint64>(numJobs) << 16));
+
+    for (auto& worker : workers)
+    {
+        if (worker->sleeping.load())
+            worker->wake.signal();
+    }
+
+    runJobs(batch);
+
+    //the barrier: whatever the workers still hold is short, so spin before giving the core away
+    for (int spin = 0; jobsRemaining.load(std::memory_order_acquire) > 0; ++spin)
+    {
+        if (spin >= spinCount)
+            std::this_thread::yield();
+    }
+}
+
+void RealtimeWorkerPool::runJobs(juce::uint32 batch) noexcept
+{
+    auto c = cursor.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        auto numJobs = static_cast<juce::uint32>((c >> 16) & 0xffff);
+        auto index = static_cast<juce::uint32>(c & 0xffff);
+
+        if (getBatch(c) != batch || index >= numJobs)
+            return;
+
+        if (!cursor.compare_exchange_weak(c, c + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+            continue;
+
+        jobFunction(jobContext, static_cast<int>(index));
+        jobsRemaining.fetch_sub(1, std::memory_order_acq_rel);
+
+        c = cursor.load(std::memory_order_acquire);
+    }
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    RealtimeWorkerPool.h
+    Created: 18 Oct 2026 9:47:12pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ A few pre-spawned real-time threads that help the audio thread with one
+ batch of jobs at a time. They are started with the host's block period, so
+ they get the same scheduling class as the audio thread that waits on them.
+
+ run() publishes the batch with one atomic store and then works on it too,
+ claiming jobs from the same counter as the workers, so small batches
+ mostly finish on the calling thread. It returns once every job is done,
+ spinning on a countdown first and then yielding. Workers spin for a
+ moment after each batch, since the next one usually follows within the
+ same block, and then sleep until run() wakes them. Nothing on the run()
+ side locks or allocates; waking a sleeping worker signals its event.
+
+ Jobs get an index, and must not touch the same data as any other job of
+ the same batch.
+ */
+class RealtimeWorkerPool
+{
+public:
+    static constexpr int maxNumWorkers = 15;
+
+    ~RealtimeWorkerPool();
+
+    //starts or stops threads, so never while run() may be called, e.g. before prepareToPlay()
+    void setNumWorkers(int newNumWorkers);
+    int getNumWorkers() const { return static_cast<int>(workers.size()); }
+
+    //the audio thread's period. restarts the workers when it changes, so only call it where setNumWorkers() may be
+    void setBlockPeriod(int samplesPerBlock, double sampleRate);
+
+    //calls job(i) for every i below numJobs, on the workers and the calling thread
+    template <typename Job>
+    void run(int numJobs, Job& job) noexcept
+    {
+        run(numJobs, [](void* context, int index) { (*static_cast<Job*>(context))(index); }, &job);
+    }
+private:
+    using JobFunction = void (*)(void*, int);
+
+    struct Worker : juce::Thread
+    {
+        explicit Worker(RealtimeWorkerPool& owner);
+        void run() override;
+
+        RealtimeWorkerPool& pool;
+        juce::WaitableEvent wake;
+        std::atomic<bool> sleeping{ false };
+    };
+
+    static constexpr int spinCount = 4096;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    int periodSamples = 0;
+    double periodSampleRate = 0.0;
+
+    //the batch. only written while no job of the previous one is still running
+    JobFunction jobFunction = nullptr;
+    void* jobContext = nullptr;
+
+    //batch number in the top 32 bits, job count in the next 16, next job to claim in the low 16.
+    //claiming compares the whole word, so a worker that's late for one batch can't claim from the next
+    std::atomic<juce::uint64> cursor{ 0 };
+    std::atomic<int> jobsRemaining{ 0 };
+
+    static juce::uint32 getBatch(juce::uint64 c) noexcept { return static_cast<juce::uint32>(c >> 32); }
+
+    void run(int numJobs, JobFunction function, void* context) noexcept;
+    void startWorker(Worker& worker) const;
+
+    //claims and runs jobs of 'batch' until there are none left
+    void runJobs(juce::uint32 batch) noexcept;
+};
@@ -26,15 +26,39 @@ struct SingleChannelSampleFifo
         prepared.set(false);
     }
 
-    void update(const BlockType& buffer)
+    //the analyzer works in float, so a double precision buffer is narrowed as it goes in.
+    //copies in runs up to the end of bufferToFill, so a block no longer than it takes at most two,
+    //and a longer one fills and queues as many buffers as it needs
+    template<typename SourceBlockType>
+    void update(const SourceBlockType& buffer)
     {
         jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse);
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        jassert(buffer.getNumChannels() > 0);
+        //mono layouts feed the same channel to both analyzers
+        auto* channelPtr = buffer.getReadPointer(juce::jmin(static_cast<int>(channelToUse), buffer.getNumChannels() - 1));
+        auto* dest = bufferToFill.getWritePointer(0);
 
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        const auto numSamples = buffer.getNumSamples();
+        const auto capacity = bufferToFill.getNumSamples();
+        if (capacity <= 0)
+            return;
+
+        for (int start = 0; start < numSamples;)
         {
-            pushNextSampleIntoFifo(channelPtr[i]);
+            auto numToCopy = juce::jmin(numSamples - start, capacity - fifoIndex);
+            copySamples(dest + fifoIndex, channelPtr + start, numToCopy);
+
+            fifoIndex += numToCopy;
+            start += numToCopy;
+
+            if (fifoIndex == capacity)
+            {
+                auto ok = audioBufferFifo.push(bufferToFill);
+
+                juce::ignoreUnused(ok);
+
+                fifoIndex = 0;
+            }
         }
     }
 
@@ -57,7 +81,10 @@ struct SingleChannelSampleFifo
     bool isPrepared() const { return prepared.get(); }
     int getSize() const { return size.get(); }
     //==============================================================================
+    //copies into 'buf' without reallocating once it has been this size
     bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
+    //buffers that were thrown away because the reader had fallen behind
+    juce::uint32 getNumDroppedBuffers() const { return audioBufferFifo.getNumOverflows(); }
 private:
     Channel channelToUse;
     int fifoIndex = 0;
@@ -66,18 +93,17 @@ private:
     juce::Atomic<bool> prepared = false;
     juce::Atomic<int> size = 0;
 
-    void pushNextSampleIntoFifo(float sample)
+    static void copySamples(float* dest, const float* source, int numSamples)
     {
-        if (fifoIndex == bufferToFill.getNumSamples())
-        {
-            auto ok = audioBufferFifo.push(bufferToFill);
-
-            juce::ignoreUnused(ok);
+        juce::FloatVectorOperations::copy(dest, source, numSamples);
+    }
 
-            fifoIndex = 0;
+    static void copySamples(float* dest, const double* source, int numSamples)
+    {
+        //a plain loop the compiler vectorises, FloatVectorOperations has no narrowing copy
+        for (int i = 0; i < numSamples; ++i)
+        {
+            dest[i] = static_cast<float>(source[i]);
         }
-
-        bufferToFill.setSample(0, fifoIndex, sample);
-        ++fifoIndex;
     }
 };
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    SlidingWindowMaximum.h
+    Created: 18 Oct 2026 8:41:05pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Maximum of the last windowLength values, one value at a time.
+
+ Keeps a monotonic deque: every value that can still become the maximum,
+ oldest and largest first. A new value drops everything smaller than it
+ from the back, and the front leaves once it's older than the window, so
+ each value goes in and out once and the cost per value is constant
+ whatever the window length.
+ */
+template <typename SampleType>
+struct SlidingWindowMaximum
+{
+    //allocates, so call it from prepareToPlay()
+    void prepare(int maxWindowLength)
+    {
+        jassert(maxWindowLength > 0);
+
+        //one spare slot for the value that's pushed before the oldest one leaves
+        auto capacity = static_cast<size_t>(juce::nextPowerOfTwo(maxWindowLength + 1));
+        values.resize(capacity);
+        times.resize(capacity);
+        mask = static_cast<juce::uint32>(capacity - 1);
+
+        maxLength = maxWindowLength;
+        windowLength = juce::jmin(windowLength, maxLength);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        head = tail = 0;
+        time = 0;
+    }
+
+    void setWindowLength(int newWindowLength) noexcept
+    {
+        jassert(newWindowLength > 0 && newWindowLength <= maxLength);
+        windowLength = juce::jlimit(1, maxLength, newWindowLength);
+    }
+
+    int getWindowLength() const noexcept { return windowLength; }
+
+    SampleType process(SampleType value) noexcept
+    {
+        while (tail != head && values[(tail - 1) & mask] <= value)
+            --tail;
+
+        values[tail & mask] = value;
+        times[tail & mask] = time;
+        ++tail;
+
+        //unsigned differences, so the counters are free to wrap
+        while (time - times[head & mask] >= static_cast<juce::uint32>(windowLength))
+            ++head;
+
+        ++time;
+        return values[head & mask];
+    }
+private:
+    std::vector<SampleType> values;
+    std::vector<juce::uint32> times;
+    juce::uint32 mask = 0;
+
+    juce::uint32 head = 0, tail = 0;
+    juce::uint32 time = 0;
+
+    int maxLength = 1;
+    int windowLength = 1;
+};
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    TelemetryRing.h
+    Created: 18 Oct 2026 11:48:05pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+/*
+ A queue of small records from one writer thread to one reader thread.
+
+ Unlike TripleBuffer, which only keeps the latest version, every record
+ pushed is kept until the reader pulls it, so a reader polling at a low
+ rate still sees each one. Neither side locks, allocates or waits: when
+ the ring is full the record is dropped and counted instead.
+ */
+template<typename T, int Capacity>
+struct TelemetryRing
+{
+    static_assert(std::is_trivially_copyable_v<T>, "records are copied in and out of the ring");
+
+    //writer side. false, and counted as dropped, if the reader has fallen Capacity records behind
+    bool push(const T& t) noexcept
+    {
+        auto write = fifo.write(1);
+        if (write.blockSize1 > 0)
+        {
+            records[static_cast<size_t>(write.startIndex1)] = t;
+            return true;
+        }
+
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    //reader side
+    bool pull(T& t) noexcept
+    {
+        auto read = fifo.read(1);
+        if (read.blockSize1 > 0)
+        {
+            t = records[static_cast<size_t>(read.startIndex1)];
+            return true;
+        }
+
+        return false;
+    }
+
+    //reader side: throws away everything queued, e.g. what piled up while nobody was reading
+    void discard() noexcept
+    {
+        fifo.read(fifo.getNumReady());
+    }
+
+    int getNumAvailableForReading() const noexcept { return fifo.getNumReady(); }
+
+    //records lost to a full ring since construction
+    juce::uint32 getNumDropped() const noexcept { return dropped.load(std::memory_order_relaxed); }
+private:
+    //AbstractFifo keeps one slot free to tell full from empty
+    std::array<T, Capacity + 1> records{};
+    juce::AbstractFifo fifo{ Capacity + 1 };
+    std::atomic<juce::uint32> dropped{ 0 };
+};
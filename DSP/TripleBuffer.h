@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 18 Oct 2026 7:12:40pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+/*
+ Hands the latest version of a T from one writer thread to one reader
+ thread without locks, copies or allocation.
+
+ The writer fills getWriteBuffer() and publish()es it; the reader calls
+ acquire() and then reads getReadBuffer(). Neither side ever waits: the
+ writer always has a buffer of its own to fill, and the reader keeps the
+ one it has until a newer one is published. Versions the reader never
+ picked up are simply overwritten.
+ */
+template<typename T>
+struct TripleBuffer
+{
+    //call while neither thread is using the buffers, e.g. to size them in prepareToPlay()
+    template<typename Fn>
+    void forEach(Fn&& fn)
+    {
+        for (auto& buffer : buffers)
+        {
+            fn(buffer);
+        }
+    }
+
+    //call while neither thread is using the buffers
+    void reset()
+    {
+        frontIndex = 0;
+        middle.store(1);
+        backIndex = 2;
+    }
+
+    //writer side
+    T& getWriteBuffer() noexcept { return buffers[static_cast<size_t>(backIndex)]; }
+
+    void publish() noexcept
+    {
+        backIndex = middle.exchange(backIndex | newDataFlag) & indexMask;
+    }
+
+    //reader side
+    bool hasNewData() const noexcept { return (middle.load() & newDataFlag) != 0; }
+
+    //swaps in the most recently published buffer. returns false if nothing new was published
+    bool acquire() noexcept
+    {
+        if (!hasNewData())
+            return false;
+
+        frontIndex = middle.exchange(frontIndex) & indexMask;
+        return true;
+    }
+
+    const T& getReadBuffer() const noexcept { return buffers[static_cast<size_t>(frontIndex)]; }
+private:
+    static constexpr int indexMask = 0x3;
+    static constexpr int newDataFlag = 0x4;
+
+    std::array<T, 3> buffers;
+
+    int frontIndex = 0;          //reader only
+    std::atomic<int> middle{ 1 };
+    int backIndex = 2;           //writer only
+};
@@ -30,7 +30,9 @@ struct AnalyzerPathGenerator
 
         int numBins = (int)fftSize / 2;
 
-        PathType p;
+        //the path swapped back out of the fifo last time, so its storage is reused
+        auto& p = path;
+        p.clear();
         p.preallocateSpace(3 * (int)fftBounds.getWidth());
 
         auto map = [bottom, top, negativeInfinity](float v)
@@ -65,7 +67,7 @@ struct AnalyzerPathGenerator
             }
         }
 
-        pathFifo.push(p);
+        pathFifo.pushBySwapping(p);
     }
 
     int getNumPathsAvailable() const
@@ -73,10 +75,12 @@ struct AnalyzerPathGenerator
         return pathFifo.getNumAvailableForReading();
     }
 
+    //'path' is swapped with the oldest queued one
     bool getPath(PathType& path)
     {
-        return pathFifo.pull(path);
+        return pathFifo.pullBySwapping(path);
     }
 private:
     Fifo<PathType> pathFifo;
+    PathType path;
 };
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    AnalyzerThread.cpp
+    Created: 18 Oct 2026 11:58:26pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include "AnalyzerThread.h"
+
+AnalyzerThread::AnalyzerThread(AnalyzerCaptureRing& ring) :
+    juce::Thread("MBComp Analyzer"),
+    leftPathProducer(ring, AnalyzerCaptureRing::View::left),
+    rightPathProducer(ring, AnalyzerCaptureRing::View::right)
+{
+    publishSettings();
+    startThread(juce::Thread::Priority::low);
+}
+
+AnalyzerThread::~AnalyzerThread()
+{
+    //the producers are still alive here, and the thread is done with them once this returns
+    stopThread(1000);
+}
+
+void AnalyzerThread::setAnalysisArea(juce::Rectangle<float> fftBounds, float negativeInfinity)
+{
+    settings.fftBounds = fftBounds;
+    settings.negativeInfinity = negativeInfinity;
+    publishSettings();
+}
+
+void AnalyzerThread::setSampleRate(double sampleRate)
+{
+    //called every frame, so only the changes are sent
+    if (sampleRate != settings.sampleRate)
+    {
+        settings.sampleRate = sampleRate;
+        publishSettings();
+    }
+}
+
+void AnalyzerThread::setEnabled(bool enabled)
+{
+    settings.enabled = enabled;
+    publishSettings();
+}
+
+void AnalyzerThread::setHopSize(int numSamples)
+{
+    settings.hopSize = numSamples;
+    publishSettings();
+}
+
+bool AnalyzerThread::acquirePaths()
+{
+    auto leftChanged = leftPathProducer.acquirePath();
+    auto rightChanged = rightPathProducer.acquirePath();
+    return leftChanged || rightChanged;
+}
+
+void AnalyzerThread::publishSettings()
+{
+    settingsBuffer.getWriteBuffer() = settings;
+    settingsBuffer.publish();
+}
+
+void AnalyzerThread::run()
+{
+    Settings current;
+    auto nextFrame = juce::Time::getMillisecondCounterHiRes();
+
+    while (!threadShouldExit())
+    {
+        if (settingsBuffer.acquire())
+            current = settingsBuffer.getReadBuffer();
+
+        if (current.enabled && current.sampleRate > 0.0 && !current.fftBounds.isEmpty())
+        {
+            for (auto* producer : { &leftPathProducer, &rightPathProducer })
+            {
+                producer->updateNegativeInfinity(current.negativeInfinity);
+                producer->setHopSize(current.hopSize);
+                producer->process(current.fftBounds, current.sampleRate);
+            }
+        }
+
+        nextFrame += 1000.0 / framesPerSecond;
+        auto now = juce::Time::getMillisecondCounterHiRes();
+
+        //a frame that ran late isn't made up for with a burst of them
+        if (nextFrame <= now)
+            nextFrame = now;
+        else
+            wait(static_cast<int>(nextFrame - now));
+    }
+}
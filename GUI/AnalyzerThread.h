@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    AnalyzerThread.h
+    Created: 18 Oct 2026 11:58:26pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PathProducer.h"
+#include "../DSP/TripleBuffer.h"
+
+/*
+ Runs the spectrum analyzer's FFTs and builds its paths on a low priority
+ thread of its own, about 60 times a second, so the message thread only
+ draws them. Each channel gets at most one FFT a frame (see PathProducer).
+
+ The area to draw into and the sample rate go to the thread through a
+ TripleBuffer, and each channel's finished path comes back through another
+ (see PathProducer), so neither thread ever waits for the other. The thread
+ starts with the analyzer and stops when it's destroyed with the editor.
+ */
+struct AnalyzerThread : juce::Thread
+{
+    explicit AnalyzerThread(AnalyzerCaptureRing& ring);
+    ~AnalyzerThread() override;
+
+    //message thread. 'fftBounds' is where the paths are drawn, with x measured from its left edge
+    void setAnalysisArea(juce::Rectangle<float> fftBounds, float negativeInfinity);
+    void setSampleRate(double sampleRate);
+    void setEnabled(bool enabled);
+
+    //message thread: samples between two FFTs, see PathProducer::setHopSize()
+    void setHopSize(int numSamples);
+
+    //message thread: picks up the paths finished since the last call. true if either changed
+    bool acquirePaths();
+
+    const juce::Path& getLeftPath() const { return leftPathProducer.getPath(); }
+    const juce::Path& getRightPath() const { return rightPathProducer.getPath(); }
+
+    void run() override;
+private:
+    struct Settings
+    {
+        juce::Rectangle<float> fftBounds;
+        float negativeInfinity = -48.f;
+        double sampleRate = 0.0;
+        int hopSize = 512;  //a quarter of the 2048 point window
+        bool enabled = true;
+    };
+
+    static constexpr double framesPerSecond = 60.0;
+
+    PathProducer leftPathProducer, rightPathProducer;
+
+    Settings settings;                      //message thread only
+    TripleBuffer<Settings> settingsBuffer;
+
+    void publishSettings();
+};
@@ -43,22 +43,6 @@ ratioSlider(nullptr, "")
     addAndMakeVisible(soloButton);
     addAndMakeVisible(muteButton);
 
-    lowBand.setName("Low");
-    lowBand.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::grey);
-    lowBand.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
-
-    midBand.setName("Mid");
-    midBand.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::grey);
-    midBand.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
-
-    highBand.setName("High");
-    highBand.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::grey);
-    highBand.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
-
-    lowBand.setRadioGroupId(1);
-    midBand.setRadioGroupId(1);
-    highBand.setRadioGroupId(1);
-
     auto buttonSwitcher = [safePtr = this->safePtr]()
     {
         if (auto* c = safePtr.getComponent())
@@ -67,19 +51,27 @@ ratioSlider(nullptr, "")
         }
     };
 
-    lowBand.onClick = buttonSwitcher;
-    midBand.onClick = buttonSwitcher;
-    highBand.onClick = buttonSwitcher;
+    for (int i = 0; i < Params::NumBands; ++i)
+    {
+        auto& band = bandButtons[static_cast<size_t>(i)];
 
-    lowBand.setToggleState(true, juce::NotificationType::dontSendNotification);
+        band.setName(Params::getBandName(i));
+        band.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::grey);
+        band.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+        band.setRadioGroupId(1);
+        band.onClick = buttonSwitcher;
+    }
+
+    bandButtons.front().setToggleState(true, juce::NotificationType::dontSendNotification);
 
     updateAttachments();
     updateSliderEnablements();
     updateBandSelectButtonStates();
 
-    addAndMakeVisible(lowBand);
-    addAndMakeVisible(midBand);
-    addAndMakeVisible(highBand);
+    for (auto& band : bandButtons)
+    {
+        addAndMakeVisible(band);
+    }
 }
 
 BandControls::~BandControls()
@@ -113,7 +105,13 @@ void BandControls::resized()
     };
 
     auto buttonBox = createButtonBox({ &bypassButton, &soloButton, &muteButton });
-    auto selectBox = createButtonBox({ &lowBand, &midBand, &highBand });
+    std::vector<Component*> bandComps;
+    for (auto& band : bandButtons)
+    {
+        bandComps.push_back(&band);
+    }
+
+    auto selectBox = createButtonBox(bandComps);
 
     FlexBox flexBox;
     flexBox.flexDirection = FlexBox::Direction::row;
@@ -152,19 +150,17 @@ void BandControls::buttonClicked(juce::Button* button)
 
 void BandControls::toggleAllBands(bool bypassed)
 {
-    std::vector<Component*> bands{ &lowBand, &midBand, &highBand };
-
-    for (auto* band : bands)
+    for (auto& band : bandButtons)
     {
-        band->setColour(juce::TextButton::ColourIds::buttonOnColourId, 
+        band.setColour(juce::TextButton::ColourIds::buttonOnColourId, 
                         bypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) : 
                         juce::Colours::grey);
 
-        band->setColour(juce::TextButton::ColourIds::buttonColourId,
+        band.setColour(juce::TextButton::ColourIds::buttonColourId,
                         bypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) :
                         juce::Colours::black);
 
-        band->repaint();
+        band.repaint();
     }
 }
 
@@ -199,13 +195,6 @@ void BandControls::refreshButtonColors(juce::Button& band, juce::Button& colorSo
 void BandControls::updateBandSelectButtonStates()
 {
     using namespace Params;
-    std::vector<std::array<Names, 3>> checkParams
-    {
-        {Names::LowSolo, Names::LowMute, Names::LowBypassed},
-        {Names::MidSolo, Names::MidMute, Names::MidBypassed},
-        {Names::HighSolo, Names::HighMute, Names::HighBypassed}
-    };
-
     const auto& params = GetParams();
 
     auto paramHelper = [&params, this](const auto& name)
@@ -213,21 +202,19 @@ void BandControls::updateBandSelectButtonStates()
         return dynamic_cast<juce::AudioParameterBool*>(&getParam(apvts, params, name));
     };
 
-    for (size_t i = 0; i < checkParams.size(); ++i)
+    for (int i = 0; i < NumBands; ++i)
     {
-        auto& list = checkParams[i];
+        auto* bandButton = &bandButtons[static_cast<size_t>(i)];
 
-        auto* bandButton = (i == 0) ? &lowBand : (i == 1) ? &midBand : &highBand;
-
-        if (auto* solo = paramHelper(list[0]); solo->get())
+        if (auto* solo = paramHelper(getBandParam(Names::Solo, i)); solo->get())
         {
             refreshButtonColors(*bandButton, soloButton);
         }
-        else if (auto* mute = paramHelper(list[1]); mute->get())
+        else if (auto* mute = paramHelper(getBandParam(Names::Mute, i)); mute->get())
         {
             refreshButtonColors(*bandButton, muteButton);
         }
-        else if (auto* bypass = paramHelper(list[2]); bypass->get())
+        else if (auto* bypass = paramHelper(getBandParam(Names::Bypassed, i)); bypass->get())
         {
             refreshButtonColors(*bandButton, bypassButton);
         }
@@ -264,79 +251,29 @@ void BandControls::updateButtonStates(juce::Button& button)
 
 void BandControls::updateAttachments()
 {
-    enum BandType
-    {
-        Low,
-        Mid,
-        High
-    };
-
-    BandType bandType = [this]()
+    auto band = 0;
+    for (int i = 0; i < Params::NumBands; ++i)
     {
-        if (lowBand.getToggleState())
+        if (bandButtons[static_cast<size_t>(i)].getToggleState())
         {
-            return BandType::Low;
+            band = i;
+            break;
         }
-        if (midBand.getToggleState())
-        {
-            return BandType::Mid;
-        }
-
-        return BandType::High;
-    }();
+    }
 
     using namespace Params;
-    std::vector<Names> names;
-
-    switch (bandType)
-    {
-    case Low:
-    {
-        names = std::vector<Names>
-        {
-            Names::LowAttack,
-            Names::LowRelease,
-            Names::LowThreshold,
-            Names::LowRatio,
-            Names::LowMute,
-            Names::LowSolo,
-            Names::LowBypassed
-        };
-        activeBand = &lowBand;
-        break;
-    }
-    case Mid:
-    {
-        names = std::vector<Names>
-        {
-            Names::MidAttack,
-            Names::MidRelease,
-            Names::MidThreshold,
-            Names::MidRatio,
-            Names::MidMute,
-            Names::MidSolo,
-            Names::MidBypassed
-        };
-        activeBand = &midBand;
-        break;
-    }
-    case High:
+    std::vector<Names> names
     {
-        names = std::vector<Names>
-        {
-            Names::HighAttack,
-            Names::HighRelease,
-            Names::HighThreshold,
-            Names::HighRatio,
-            Names::HighMute,
-            Names::HighSolo,
-            Names::HighBypassed
-        };
-        activeBand = &highBand;
-        break;
-    }
+        getBandParam(Names::Attack, band),
+        getBandParam(Names::Release, band),
+        getBandParam(Names::Threshold, band),
+        getBandParam(Names::Ratio, band),
+        getBandParam(Names::Mute, band),
+        getBandParam(Names::Solo, band),
+        getBandParam(Names::Bypassed, band)
+    };
 
-    }
+    activeBand = &bandButtons[static_cast<size_t>(band)];
 
     enum Pos
     {
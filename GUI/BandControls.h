@@ -11,6 +11,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "RotarySliderWithLabels.h"
+#include "../DSP/Params.h"
 
 struct BandControls : juce::Component, juce::Button::Listener
 {
@@ -29,14 +30,17 @@ private:
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::unique_ptr<Attachment> attackSliderATT, releaseSliderATT, thresholdSliderATT, ratioSliderATT;
 
-    juce::ToggleButton bypassButton, soloButton, muteButton, lowBand, midBand, highBand;
+    juce::ToggleButton bypassButton, soloButton, muteButton;
+
+    //one select button per band, lowest band first
+    std::array<juce::ToggleButton, Params::NumBands> bandButtons;
 
     using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
     std::unique_ptr<BtnAttachment> bypassButtonATT, soloButtonATT, muteButtonATT;
 
     juce::Component::SafePointer<BandControls> safePtr{ this };
 
-    juce::ToggleButton* activeBand = &lowBand;
+    juce::ToggleButton* activeBand = &bandButtons.front();
 
     void updateAttachments();
     void updateSliderEnablements();
@@ -20,12 +20,22 @@ struct FFTDataGenerator
      produces the FFT data from an audio buffer.
      */
     void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
+    {
+        produceFFTDataForRendering(audioData.getReadPointer(0), 0, negativeInfinity);
+    }
+
+    /**
+     produces the FFT data from a circular buffer of getFFTSize() samples, the oldest at 'oldestIndex'.
+     */
+    void produceFFTDataForRendering(const float* samples, int oldestIndex, const float negativeInfinity)
     {
         const auto fftSize = getFFTSize();
+        jassert(oldestIndex >= 0 && oldestIndex < fftSize);
 
-        fftData.assign(fftData.size(), 0);
-        auto* readIndex = audioData.getReadPointer(0);
-        std::copy(readIndex, readIndex + fftSize, fftData.begin());
+        //unwrapped into fftData, which the FFT works in anyway. the top half is the transform's scratch space
+        std::copy(samples + oldestIndex, samples + fftSize, fftData.begin());
+        std::copy(samples, samples + oldestIndex, fftData.begin() + (fftSize - oldestIndex));
+        std::fill(fftData.begin() + fftSize, fftData.end(), 0.f);
 
         // first apply a windowing function to our data
         window->multiplyWithWindowingTable(fftData.data(), fftSize);       // [1]
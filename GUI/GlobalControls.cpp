@@ -22,13 +22,9 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
     };
 
     auto& inGainParam = getParamHelper(Names::GainIn);
-    auto& lowMidParam = getParamHelper(Names::LowMidCrossoverFreq);
-    auto& midHighParam = getParamHelper(Names::MidHighCrossoverFreq);
     auto& outGainParam = getParamHelper(Names::GainOut);
 
     inGainSlider = std::make_unique<RSWL>(&inGainParam, "dB", "INPUT GAIN");
-    lowMidSlider = std::make_unique<RSWL>(&lowMidParam, "Hz", "LOW-MID X-OVER");
-    midHighSlider = std::make_unique<RSWL>(&midHighParam, "Hz", "MID-HI X-OVER");
     outGainSlider = std::make_unique<RSWL>(&outGainParam, "dB", "OUTPUT GAIN");
 
     auto makeAttachmentHelper = [&params, &apvts](auto& attachment, const auto& name, auto& slider)
@@ -37,18 +33,33 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
     };
 
     makeAttachmentHelper(inGainSliderATT, Names::GainIn, *inGainSlider);
-    makeAttachmentHelper(lowMidSliderATT, Names::LowMidCrossoverFreq, *lowMidSlider);
-    makeAttachmentHelper(midHighSliderATT, Names::MidHighCrossoverFreq, *midHighSlider);
     makeAttachmentHelper(outGainSliderATT, Names::GainOut, *outGainSlider);
 
     addLabelPairs(inGainSlider->labels, inGainParam, "dB");
-    addLabelPairs(lowMidSlider->labels, lowMidParam, "Hz");
-    addLabelPairs(midHighSlider->labels, midHighParam, "Hz");
     addLabelPairs(outGainSlider->labels, outGainParam, "dB");
 
     addAndMakeVisible(*inGainSlider);
-    addAndMakeVisible(*lowMidSlider);
-    addAndMakeVisible(*midHighSlider);
+
+    for (int i = 0; i < NumCrossovers; ++i)
+    {
+        auto name = getCrossoverParam(i);
+        auto& param = getParamHelper(name);
+        auto& slider = crossoverSliders[static_cast<size_t>(i)];
+
+        auto title = getBandName(i).toUpperCase() + "-" + getBandName(i + 1).toUpperCase() + " X-OVER";
+        slider = std::make_unique<RSWL>(&param, "Hz", title);
+
+        makeAttachmentHelper(crossoverSliderATTs[static_cast<size_t>(i)], name, *slider);
+        addLabelPairs(slider->labels, param, "Hz");
+        addAndMakeVisible(*slider);
+    }
+
+    auto& lookaheadParam = getParamHelper(Names::Lookahead);
+    lookaheadSlider = std::make_unique<RSWL>(&lookaheadParam, "ms", "LOOKAHEAD");
+    makeAttachmentHelper(lookaheadSliderATT, Names::Lookahead, *lookaheadSlider);
+    addLabelPairs(lookaheadSlider->labels, lookaheadParam, "ms");
+    addAndMakeVisible(*lookaheadSlider);
+
     addAndMakeVisible(*outGainSlider);
 }
 
@@ -72,9 +83,12 @@ void GlobalControls::resized()
     flexBox.items.add(endCap);
     flexBox.items.add(FlexItem(*inGainSlider).withFlex(1.f));
     flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(*lowMidSlider).withFlex(1.f));
-    flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(*midHighSlider).withFlex(1.f));
+    for (auto& slider : crossoverSliders)
+    {
+        flexBox.items.add(FlexItem(*slider).withFlex(1.f));
+        flexBox.items.add(spacer);
+    }
+    flexBox.items.add(FlexItem(*lookaheadSlider).withFlex(1.f));
     flexBox.items.add(spacer);
     flexBox.items.add(FlexItem(*outGainSlider).withFlex(1.f));
     flexBox.items.add(endCap);
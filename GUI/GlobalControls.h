@@ -12,6 +12,7 @@
 #include <JuceHeader.h>
 #include "RotarySliderWithLabels.h"
 #include "Utilities.h"
+#include "../DSP/Params.h"
 
 struct GlobalControls : juce::Component
 {
@@ -22,8 +23,10 @@ struct GlobalControls : juce::Component
     void resized() override;
 private:
     using RSWL = RotarySliderWithLabels;
-    std::unique_ptr<RSWL> inGainSlider, lowMidSlider, midHighSlider, outGainSlider;
+    std::unique_ptr<RSWL> inGainSlider, outGainSlider, lookaheadSlider;
+    std::array<std::unique_ptr<RSWL>, Params::NumCrossovers> crossoverSliders;
 
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-    std::unique_ptr<Attachment> lowMidSliderATT, midHighSliderATT, inGainSliderATT, outGainSliderATT;
+    std::unique_ptr<Attachment> inGainSliderATT, outGainSliderATT, lookaheadSliderATT;
+    std::array<std::unique_ptr<Attachment>, Params::NumCrossovers> crossoverSliderATTs;
 };
\ No newline at end of file
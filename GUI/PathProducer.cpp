@@ -12,43 +12,53 @@
 
 void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
 {
-    juce::AudioBuffer<float> tempIncomingBuffer;
-    while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0)
-    {
-        if (leftChannelFifo->getAudioBuffer(tempIncomingBuffer))
-        {
-            auto size = tempIncomingBuffer.getNumSamples();
+    const auto fftSize = monoBuffer.getNumSamples();
 
-            jassert(size <= monoBuffer.getNumSamples());
-            size = juce::jmin(size, monoBuffer.getNumSamples());
+    //only the newest window is analysed, so audio older than that isn't even read
+    samplesSinceLastFFT += capture->skipToLatest(reader, fftSize);
 
-            auto writePointer = monoBuffer.getWritePointer(0, 0);
-            auto readPointer = monoBuffer.getReadPointer(0, size);
+    for (auto available = capture->getNumAvailable(reader); available > 0; available = capture->getNumAvailable(reader))
+    {
+        //at most two runs, either side of the end of the window
+        auto numToRead = juce::jmin(available, fftSize - writeIndex);
+        auto numRead = capture->read(reader, view, monoBuffer.getWritePointer(0, writeIndex), numToRead);
 
-            std::copy(readPointer, readPointer + (monoBuffer.getNumSamples() - size), writePointer);
+        //0 if the audio thread lapped this reader while it read, and then it starts again from the newest window
+        if (numRead == 0)
+        {
+            samplesSinceLastFFT += capture->skipToLatest(reader, fftSize);
+            continue;
+        }
 
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                tempIncomingBuffer.getReadPointer(0, 0),
-                size);
+        writeIndex = (writeIndex + numRead) % fftSize;
+        samplesSinceLastFFT += static_cast<juce::uint64>(numRead);
+    }
 
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInfinity);
-        }
+    //one FFT however many hops have gone by, keeping the hop phase
+    const auto hop = static_cast<juce::uint64>(hopSize);
+    if (samplesSinceLastFFT >= hop)
+    {
+        samplesSinceLastFFT %= hop;
+        leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer.getReadPointer(0), writeIndex, negativeInfinity);
     }
 
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
     const auto binWidth = sampleRate / double(fftSize);
 
     while (leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
     {
-        std::vector<float> fftData;
         if (leftChannelFFTDataGenerator.getFFTData(fftData))
         {
             pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negativeInfinity);
         }
     }
 
+    //only the newest path is drawn
+    auto gotPath = false;
     while (pathProducer.getNumPathsAvailable() > 0)
     {
-        pathProducer.getPath(leftChannelFFTPath);
+        gotPath = pathProducer.getPath(paths.getWriteBuffer()) || gotPath;
     }
+
+    if (gotPath)
+        paths.publish();
 }
\ No newline at end of file
@@ -12,30 +12,68 @@
 #include <JuceHeader.h>
 #include "FFTDataGenerator.h"
 #include "AnalyzerPathGenerator.h"
+#include "../DSP/TripleBuffer.h"
 #include "../PluginProcessor.h"
 
+/*
+ Turns one view of the capture ring into the analyzer's path.
+
+ process() runs on the analysis thread and publishes each new path through
+ a TripleBuffer; the message thread acquirePath()s it and draws getPath().
+ Paths are swapped along the way rather than copied, so their storage is
+ reused once they've all been through once.
+
+ The capture is read into a circular window of the last FFT size samples.
+ A new FFT is due once every hop size samples, and each process() call
+ runs at most one, on the newest window, however many hops and host
+ blocks it covers. So the analysis costs one FFT per display frame at
+ most, whatever the host's block size.
+ */
 struct PathProducer
 {
-    PathProducer(SingleChannelSampleFifo<MBCompAudioProcessor::BlockType>& scsf) :
-        leftChannelFifo(&scsf)
+    PathProducer(AnalyzerCaptureRing& ring, AnalyzerCaptureRing::View viewToUse) :
+        capture(&ring),
+        view(viewToUse),
+        reader(ring.makeReader())
     {
         leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
         monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
+        monoBuffer.clear();
+        hopSize = leftChannelFFTDataGenerator.getFFTSize() / 4;
     }
+
+    //analysis thread
     void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
+
+    //analysis thread: the samples between two FFTs, from 1 up to the FFT size (no overlap). defaults to a quarter of it
+    void setHopSize(int numSamples) { hopSize = juce::jlimit(1, monoBuffer.getNumSamples(), numSamples); }
+    int getHopSize() const { return hopSize; }
+
+    //message thread: true if a newer path was published since the last call
+    bool acquirePath() { return paths.acquire(); }
+    const juce::Path& getPath() const { return paths.getReadBuffer(); }
 
     void updateNegativeInfinity(float nf) { negativeInfinity = nf; }
 private:
-    SingleChannelSampleFifo<MBCompAudioProcessor::BlockType>* leftChannelFifo;
+    AnalyzerCaptureRing* capture;
+    AnalyzerCaptureRing::View view;
+    AnalyzerCaptureRing::Reader reader;
 
+    //circular: the oldest sample is at writeIndex, where the next one read goes
     juce::AudioBuffer<float> monoBuffer;
+    int writeIndex = 0;
+
+    int hopSize = 512;
+    juce::uint64 samplesSinceLastFFT = 0;
+
+    //what the fifo is read into. it keeps its size between calls, so reading doesn't allocate
+    std::vector<float> fftData;
 
     FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
 
     AnalyzerPathGenerator<juce::Path> pathProducer;
 
-    juce::Path leftChannelFFTPath;
+    TripleBuffer<juce::Path> paths;
 
     float negativeInfinity{ -48.f };
 };
\ No newline at end of file
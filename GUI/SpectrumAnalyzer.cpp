@@ -14,8 +14,7 @@
 
 SpectrumAnalyzer::SpectrumAnalyzer(MBCompAudioProcessor& p) :
     audioProcessor(p),
-    leftPathProducer(audioProcessor.leftChannelFifo),
-    rightPathProducer(audioProcessor.rightChannelFifo)
+    analyzerThread(audioProcessor.analyzerCapture)
 {
     const auto& params = audioProcessor.getParameters();
     for (auto param : params)
@@ -32,12 +31,15 @@ SpectrumAnalyzer::SpectrumAnalyzer(MBCompAudioProcessor& p) :
         jassert(param != nullptr);
     };
 
-    floatHelper(lowMidParam, Names::LowMidCrossoverFreq);
-    floatHelper(midHighParam, Names::MidHighCrossoverFreq);
+    for (int i = 0; i < NumCrossovers; ++i)
+    {
+        floatHelper(crossoverParams[static_cast<size_t>(i)], getCrossoverParam(i));
+    }
 
-    floatHelper(lowThresholdParam, Names::LowThreshold);
-    floatHelper(midThresholdParam, Names::MidThreshold);
-    floatHelper(highThresholdParam, Names::HighThreshold);
+    for (int i = 0; i < NumBands; ++i)
+    {
+        floatHelper(thresholdParams[static_cast<size_t>(i)], getBandParam(Names::Threshold, i));
+    }
 
     startTimerHz(60);
 }
@@ -59,17 +61,14 @@ void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> b
     Graphics::ScopedSaveState sss(g);
     g.reduceClipRegion(responseArea);
 
-    auto leftChannelFFTPath = leftPathProducer.getPath();
-    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
+    //the analysis thread built the paths, so this only draws them
+    auto toResponseArea = AffineTransform::translation(static_cast<float>(responseArea.getX()), 0.f);
 
     g.setColour(Colour(97u, 18u, 167u)); //purple-
-    g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
-
-    auto rightChannelFFTPath = rightPathProducer.getPath();
-    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
+    g.strokePath(analyzerThread.getLeftPath(), PathStrokeType(1.f), toResponseArea);
 
     g.setColour(Colour(215u, 201u, 134u));
-    g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
+    g.strokePath(analyzerThread.getRightPath(), PathStrokeType(1.f), toResponseArea);
 }
 
 void SpectrumAnalyzer::paint(juce::Graphics& g)
@@ -108,12 +107,17 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bo
         return left + width * normX;
     };
 
-    auto lowMidX = mapX(lowMidParam->get());
-    g.setColour(Colours::orange);
-    g.drawVerticalLine(lowMidX, top, bottom);
+    //band i spans bandEdges[i] to bandEdges[i + 1]
+    std::array<float, Params::NumBands + 1> bandEdges;
+    bandEdges.front() = static_cast<float>(left);
+    bandEdges.back() = static_cast<float>(right);
 
-    auto midHighX = mapX(midHighParam->get());
-    g.drawVerticalLine(midHighX, top, bottom);
+    g.setColour(Colours::orange);
+    for (size_t i = 0; i < crossoverParams.size(); ++i)
+    {
+        bandEdges[i + 1] = mapX(crossoverParams[i]->get());
+        g.drawVerticalLine(bandEdges[i + 1], top, bottom);
+    }
 
     auto mapY = [bottom, top](float db)
     {
@@ -122,33 +126,44 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bo
 
     auto zeroDb = mapY(0.f);
     g.setColour(Colours::green.withAlpha(0.3f));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(left, zeroDb, lowMidX, mapY(lowBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(lowMidX, zeroDb, midHighX, mapY(midBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(midHighX, zeroDb, right, mapY(highBandGR)));
+    for (size_t i = 0; i < bandGRs.size(); ++i)
+    {
+        g.fillRect(Rectangle<float>::leftTopRightBottom(bandEdges[i], zeroDb, bandEdges[i + 1], mapY(bandGRs[i])));
+    }
+
+    g.setColour(Colours::green);
+    for (size_t i = 0; i < heldGRs.size(); ++i)
+    {
+        if (heldGRs[i] < 0.f)
+            g.drawHorizontalLine(juce::roundToInt(mapY(heldGRs[i])), bandEdges[i], bandEdges[i + 1]);
+    }
 
     g.setColour(Colours::yellow);
-    g.drawHorizontalLine(mapY(lowThresholdParam->get()), left, lowMidX);
-    g.drawHorizontalLine(mapY(midThresholdParam->get()), lowMidX, midHighX);
-    g.drawHorizontalLine(mapY(highThresholdParam->get()), midHighX, right);
+    for (size_t i = 0; i < thresholdParams.size(); ++i)
+    {
+        g.drawHorizontalLine(mapY(thresholdParams[i]->get()), bandEdges[i], bandEdges[i + 1]);
+    }
 }
 
-void SpectrumAnalyzer::update(const std::vector<float> &values)
+void SpectrumAnalyzer::updateGainReduction(const std::array<float, Params::NumBands>& deepest, float seconds)
 {
-    jassert(values.size() == 6);
-    
-    enum
+    auto release = grReleaseDbPerSecond * seconds;
+
+    for (size_t i = 0; i < bandGRs.size(); ++i)
     {
-        LowBandIn,
-        LowBandOut,
-        MidBandIn,
-        MidBandOut,
-        HighBandIn,
-        HighBandOut
-    };
+        bandGRs[i] = juce::jmin(deepest[i], bandGRs[i] + release);
 
-    lowBandGR = values[LowBandOut] - values[LowBandIn];
-    midBandGR = values[MidBandOut] - values[MidBandIn];
-    highBandGR = values[HighBandOut] - values[HighBandIn];
+        if (bandGRs[i] <= heldGRs[i])
+        {
+            heldGRs[i] = bandGRs[i];
+            grHoldTimes[i] = 0.f;
+        }
+        else if ((grHoldTimes[i] += seconds) > grHoldSeconds)
+        {
+            //the held peak falls back at the release rate, never below the bar
+            heldGRs[i] = juce::jmin(heldGRs[i] + release, bandGRs[i]);
+        }
+    }
 
     repaint();
 }
@@ -299,8 +314,10 @@ void SpectrumAnalyzer::resized()
     auto bounds = getLocalBounds();
     auto fftBounds = getAnalysisArea(bounds).toFloat();
     auto nf = jmap(bounds.toFloat().getBottom(), fftBounds.getBottom(), fftBounds.getY(), NEGINF, MAXDB);
-    leftPathProducer.updateNegativeInfinity(nf);
-    rightPathProducer.updateNegativeInfinity(nf);
+
+    //the paths run down to the bottom of the component, where the floor nf maps to
+    fftBounds.setBottom(static_cast<float>(bounds.getBottom()));
+    analyzerThread.setAnalysisArea(fftBounds, nf);
 }
 
 void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
@@ -310,15 +327,11 @@ void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
 
 void SpectrumAnalyzer::timerCallback()
 {
+    analyzerThread.setSampleRate(audioProcessor.getSampleRate());
+
     if (shouldShowFFTAnalysis)
     {
-        auto bounds = getLocalBounds();
-        auto fftBounds = getAnalysisArea(bounds).toFloat();
-        fftBounds.setBottom(bounds.getBottom());
-        auto sampleRate = audioProcessor.getSampleRate();
-
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
+        analyzerThread.acquirePaths();
     }
 
     if (parametersChanged.compareAndSetBool(false, true))
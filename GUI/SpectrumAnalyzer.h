@@ -10,7 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
-#include "PathProducer.h"
+#include "AnalyzerThread.h"
 
 struct SpectrumAnalyzer : juce::Component,
     juce::AudioProcessorParameter::Listener,
@@ -31,9 +31,12 @@ struct SpectrumAnalyzer : juce::Component,
     void toggleAnalysisEnablement(bool enabled)
     {
         shouldShowFFTAnalysis = enabled;
+        analyzerThread.setEnabled(enabled);
     }
 
-    void update(const std::vector<float>& values);
+    //the deepest gain reduction of each band over the last 'seconds', in dB.
+    //the bars attack at once and release slowly, with a peak line held above them
+    void updateGainReduction(const std::array<float, Params::NumBands>& deepest, float seconds);
 private:
     MBCompAudioProcessor& audioProcessor;
 
@@ -52,20 +55,19 @@ private:
 
     juce::Rectangle<int> getAnalysisArea(juce::Rectangle<int> bounds);
 
-    PathProducer leftPathProducer, rightPathProducer;
+    AnalyzerThread analyzerThread;
 
     void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds);
 
     void drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bounds);
 
-    juce::AudioParameterFloat* lowMidParam{ nullptr };
-    juce::AudioParameterFloat* midHighParam{ nullptr };
+    std::array<juce::AudioParameterFloat*, Params::NumCrossovers> crossoverParams{};
+    std::array<juce::AudioParameterFloat*, Params::NumBands> thresholdParams{};
 
-    juce::AudioParameterFloat* lowThresholdParam{ nullptr };
-    juce::AudioParameterFloat* midThresholdParam{ nullptr };
-    juce::AudioParameterFloat* highThresholdParam{ nullptr };
+    static constexpr float grReleaseDbPerSecond = 20.f;
+    static constexpr float grHoldSeconds = 1.5f;
 
-    float lowBandGR{ 0.f };
-    float midBandGR{ 0.f };
-    float highBandGR{ 0.f };
+    std::array<float, Params::NumBands> bandGRs{};
+    std::array<float, Params::NumBands> heldGRs{};
+    std::array<float, Params::NumBands> grHoldTimes{};
 };
\ No newline at end of file
@@ -14,15 +14,59 @@ ControlBar::ControlBar()
 {
     analyzerButton.setToggleState(true, juce::NotificationType::dontSendNotification);
     addAndMakeVisible(analyzerButton);
+
+    linearPhaseButton.setName("LINEAR PHASE");
+    linearPhaseButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::yellow);
+    linearPhaseButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    addAndMakeVisible(linearPhaseButton);
+
+    sidechainButton.setName("SIDECHAIN");
+    sidechainButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::yellow);
+    sidechainButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    addAndMakeVisible(sidechainButton);
+
+    //item ids start at 1, the attachment maps them onto the choice index
+    oversamplingBox.addItemList(Params::OversamplingChoices, 1);
+    addAndMakeVisible(oversamplingBox);
+
+    //same order as the choices, only labelled so the box reads on its own
+    for (int i = 0; i < Params::ChannelLinkChoices.size(); ++i)
+    {
+        channelLinkBox.addItem("Link " + Params::ChannelLinkChoices[i], i + 1);
+    }
+    addAndMakeVisible(channelLinkBox);
+
     addAndMakeVisible(globalBypass);
+
+    loudnessButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    setLoudness({});
+    addAndMakeVisible(loudnessButton);
+}
+
+void ControlBar::setLoudness(const LoudnessMeter::Readings& readings)
+{
+    auto format = [](float value)
+    {
+        return value > LoudnessMeter::minLoudness ? juce::String(value, 1) : juce::String("-inf");
+    };
+
+    loudnessButton.setButtonText("M " + format(readings.momentary)
+                                 + "  S " + format(readings.shortTerm)
+                                 + "  I " + format(readings.integrated) + " LUFS"
+                                 + "  TP " + format(readings.truePeak));
 }
 
 void ControlBar::resized()
 {
     auto bounds = getLocalBounds();
     analyzerButton.setBounds(bounds.removeFromLeft(50).withTrimmedTop(4).withTrimmedBottom(4));
+    loudnessButton.setBounds(bounds.removeFromLeft(230).withTrimmedTop(6).withTrimmedBottom(6).withTrimmedLeft(5));
 
     globalBypass.setBounds(bounds.removeFromRight(60).withTrimmedTop(2).withTrimmedBottom(2));
+    linearPhaseButton.setBounds(bounds.removeFromRight(110).withTrimmedTop(4).withTrimmedBottom(4));
+    oversamplingBox.setBounds(bounds.removeFromRight(70).withTrimmedTop(6).withTrimmedBottom(6));
+    sidechainButton.setBounds(bounds.removeFromRight(90).withTrimmedTop(4).withTrimmedBottom(4));
+    channelLinkBox.setBounds(bounds.removeFromRight(110).withTrimmedTop(6).withTrimmedBottom(6));
 }
 
 //==============================================================================
@@ -44,6 +88,16 @@ MBCompAudioProcessorEditor::MBCompAudioProcessorEditor (MBCompAudioProcessor& p)
         toggleGlobalBypass();
     };
 
+    controlBar.loudnessButton.onClick = [this]()
+    {
+        audioProcessor.loudnessMeter.requestReset();
+    };
+
+    makeAttachment(linearPhaseButtonATT, audioProcessor.apvts, Params::GetParams(), Params::Names::LinearPhase, controlBar.linearPhaseButton);
+    makeAttachment(sidechainButtonATT, audioProcessor.apvts, Params::GetParams(), Params::Names::Sidechain, controlBar.sidechainButton);
+    makeAttachment(oversamplingBoxATT, audioProcessor.apvts, Params::GetParams(), Params::Names::Oversampling, controlBar.oversamplingBox);
+    makeAttachment(channelLinkBoxATT, audioProcessor.apvts, Params::GetParams(), Params::Names::ChannelLink, controlBar.channelLinkBox);
+
     addAndMakeVisible(controlBar);
     addAndMakeVisible(analyzer);
     addAndMakeVisible(globalControls);
@@ -51,6 +105,8 @@ MBCompAudioProcessorEditor::MBCompAudioProcessorEditor (MBCompAudioProcessor& p)
 
     setSize (720, 600);
 
+    //whatever the audio thread queued while no editor was open is stale
+    audioProcessor.telemetry.discard();
     startTimerHz(60);
 }
 
@@ -86,19 +142,27 @@ void MBCompAudioProcessorEditor::resized()
 
 void MBCompAudioProcessorEditor::timerCallback()
 {
-    std::vector<float> values
+    //every chunk processed since the last tick, so gain reduction between two ticks isn't lost
+    std::array<float, Params::NumBands> deepestGRs{};
+    MBCompAudioProcessor::TelemetryRecord record;
+
+    while (audioProcessor.telemetry.pull(record))
     {
-        audioProcessor.lowBandComp.getRMSInputLevel(),
-        audioProcessor.lowBandComp.getRMSOutputLevel(),
-        audioProcessor.midBandComp.getRMSInputLevel(),
-        audioProcessor.midBandComp.getRMSOutputLevel(),
-        audioProcessor.highBandComp.getRMSInputLevel(),
-        audioProcessor.highBandComp.getRMSOutputLevel()
-    };
+        for (size_t i = 0; i < deepestGRs.size(); ++i)
+        {
+            deepestGRs[i] = juce::jmin(deepestGRs[i], record.getGainReduction(i));
+        }
+    }
 
-    analyzer.update(values);
+    analyzer.updateGainReduction(deepestGRs, static_cast<float>(getTimerInterval()) / 1000.f);
 
     updateGlobalBypass();
+    updateLoudness();
+}
+
+void MBCompAudioProcessorEditor::updateLoudness()
+{
+    controlBar.setLoudness(audioProcessor.loudnessMeter.getReadings());
 }
 
 void MBCompAudioProcessorEditor::updateGlobalBypass()
@@ -131,7 +195,7 @@ void MBCompAudioProcessorEditor::toggleGlobalBypass()
     bandControls.toggleAllBands(!toggleState);
 }
 
-std::array<juce::AudioParameterBool*, 3> MBCompAudioProcessorEditor::getBypassParams()
+std::array<juce::AudioParameterBool*, Params::NumBands> MBCompAudioProcessorEditor::getBypassParams()
 {
     using namespace juce;
     using namespace Params;
@@ -146,14 +210,11 @@ std::array<juce::AudioParameterBool*, 3> MBCompAudioProcessorEditor::getBypassPa
         return param;
     };
 
-    auto* lowBypassParam = boolHelper(Names::LowBypassed);
-    auto* midBypassParam = boolHelper(Names::MidBypassed);
-    auto* highBypassParam = boolHelper(Names::HighBypassed);
-
-    return
+    std::array<juce::AudioParameterBool*, NumBands> bypassParams;
+    for (int i = 0; i < NumBands; ++i)
     {
-        lowBypassParam,
-        midBypassParam,
-        highBypassParam
-    };
+        bypassParams[static_cast<size_t>(i)] = boolHelper(getBandParam(Names::Bypassed, i));
+    }
+
+    return bypassParams;
 }
\ No newline at end of file
@@ -23,7 +23,15 @@ struct ControlBar : juce::Component
     void resized() override;
 
     AnalyzerButton analyzerButton;
+    juce::ToggleButton linearPhaseButton;
+    juce::ToggleButton sidechainButton;
+    juce::ComboBox oversamplingBox;
+    juce::ComboBox channelLinkBox;
     PowerButton globalBypass;
+
+    //momentary, short-term and integrated loudness and true peak of the output. click to reset
+    juce::TextButton loudnessButton;
+    void setLoudness(const LoudnessMeter::Readings& readings);
 };
 
 class MBCompAudioProcessorEditor  : public juce::AudioProcessorEditor, juce::Timer
@@ -45,15 +53,19 @@ private:
     MBCompAudioProcessor& audioProcessor;
 
     ControlBar controlBar;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> linearPhaseButtonATT, sidechainButtonATT;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingBoxATT, channelLinkBoxATT;
     GlobalControls globalControls{ audioProcessor.apvts };
     BandControls bandControls{ audioProcessor.apvts };
     SpectrumAnalyzer analyzer{ audioProcessor };
 
     void toggleGlobalBypass();
 
-    std::array<juce::AudioParameterBool*, 3> getBypassParams();
+    std::array<juce::AudioParameterBool*, Params::NumBands> getBypassParams();
 
     void updateGlobalBypass();
 
+    void updateLoudness();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MBCompAudioProcessorEditor)
 };
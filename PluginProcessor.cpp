@@ -17,6 +17,7 @@ MBCompAudioProcessor::MBCompAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
@@ -32,57 +33,43 @@ MBCompAudioProcessor::MBCompAudioProcessor()
         jassert(param != nullptr);
     };
 
-    floatHelper(lowBandComp.attack, Names::LowAttack);
-    floatHelper(lowBandComp.release, Names::LowRelease);
-    floatHelper(lowBandComp.threshold, Names::LowThreshold);
-
-    floatHelper(midBandComp.attack, Names::MidAttack);
-    floatHelper(midBandComp.release, Names::MidRelease);
-    floatHelper(midBandComp.threshold, Names::MidThreshold);
-
-    floatHelper(highBandComp.attack, Names::HighAttack);
-    floatHelper(highBandComp.release, Names::HighRelease);
-    floatHelper(highBandComp.threshold, Names::HighThreshold);
-
     auto choiceHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
     {
         param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(paramName)));
         jassert(param != nullptr);
     };
 
-    choiceHelper(lowBandComp.ratio, Names::LowRatio);
-    choiceHelper(midBandComp.ratio, Names::MidRatio);
-    choiceHelper(highBandComp.ratio, Names::HighRatio);
-
     auto boolHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
     {
         param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
         jassert(param != nullptr);
     };
 
-    boolHelper(lowBandComp.bypassed, Names::LowBypassed);
-    boolHelper(midBandComp.bypassed, Names::MidBypassed);
-    boolHelper(highBandComp.bypassed, Names::HighBypassed);
+    for (int i = 0; i < NumBands; ++i)
+    {
+        auto& comp = compressors[static_cast<size_t>(i)];
+
+        floatHelper(comp.attack, getBandParam(Names::Attack, i));
+        floatHelper(comp.release, getBandParam(Names::Release, i));
+        floatHelper(comp.threshold, getBandParam(Names::Threshold, i));
+        choiceHelper(comp.ratio, getBandParam(Names::Ratio, i));
+        boolHelper(comp.bypassed, getBandParam(Names::Bypassed, i));
+        boolHelper(comp.mute, getBandParam(Names::Mute, i));
+        boolHelper(comp.solo, getBandParam(Names::Solo, i));
+    }
 
-    boolHelper(lowBandComp.mute, Names::LowMute);
-    boolHelper(midBandComp.mute, Names::MidMute);
-    boolHelper(highBandComp.mute, Names::HighMute);
+    floatHelper(inGainParam, Names::GainIn);
+    floatHelper(outGainParam, Names::GainOut);
 
-    boolHelper(lowBandComp.solo, Names::LowSolo);
-    boolHelper(midBandComp.solo, Names::MidSolo);
-    boolHelper(highBandComp.solo, Names::HighSolo);
+    parameters.attach(apvts);
 
-    floatHelper(lowMidCrossover, Names::LowMidCrossoverFreq);
-    floatHelper(midHighCrossover, Names::MidHighCrossoverFreq);
+    for (auto* crossover : { &floatChain.crossover, &floatChain.sidechainCrossover })
+        crossover->setNumBands(NumBands);
 
-    floatHelper(inGainParam, Names::GainIn);
-    floatHelper(outGainParam, Names::GainOut);
+    for (auto* crossover : { &doubleChain.crossover, &doubleChain.sidechainCrossover })
+        crossover->setNumBands(NumBands);
 
-    LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-    HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-    AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+    linearPhaseCrossover.setNumBands(NumBands);
 }
 
 MBCompAudioProcessor::~MBCompAudioProcessor()
@@ -161,37 +148,120 @@ void MBCompAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock
     spec.numChannels = getTotalNumOutputChannels();
     spec.sampleRate = sampleRate;
 
-    for (auto & comp : compressors)
+    //the workers are real-time threads on the audio thread's period
+    workerPool.setBlockPeriod(samplesPerBlock, sampleRate);
+
+    //the host picks the precision before preparing, and only the chain it asked for is prepared
+    if (isUsingDoublePrecision())
+        prepareChain(doubleChain, spec);
+    else
+        prepareChain(floatChain, spec);
+
+    analyzerCapture.prepare(samplesPerBlock);
+
+    loudnessMeter.prepare(sampleRate, juce::jmin(getMainBusNumOutputChannels(), LoudnessMeter::maxNumChannels));
+    loudnessMeter.setChannelWeights(getLoudnessWeights(getChannelLayoutOfBus(false, 0)));
+
+    osc.initialise([](float x) {return std::sin(x); });
+    osc.prepare(spec);
+    osc.setFrequency(getSampleRate() / ((2 << FFTOrder::order2048) - 1) * 50);
+
+    gain.prepare(spec);
+    gain.setGainDecibels(-12.f);
+
+    //everything was just prepared, so push every setting again on the next block
+    parameters.markAllDirty();
+}
+
+template <typename SampleType>
+void MBCompAudioProcessor::prepareChain(ProcessChain<SampleType>& chain, const juce::dsp::ProcessSpec& spec)
+{
+    auto samplesPerBlock = static_cast<int>(spec.maximumBlockSize);
+
+    chain.multiBandCompressor.prepare(spec, Params::NumBands);
+
+    //every factor is allocated here; switching factors later only picks another one
+    chain.oversampler.prepare(spec, Params::NumBands);
+
+    //sized for the highest factor, so setOversampling() only ever shrinks it
+    auto oversampledSpec = spec;
+    oversampledSpec.sampleRate *= 1 << BandOversampler<SampleType>::maxFactorLog2;
+    oversampledSpec.maximumBlockSize *= 1u << BandOversampler<SampleType>::maxFactorLog2;
+    chain.oversampledCompressor.prepare(oversampledSpec, Params::NumBands);
+
+    //the linear phase kernels are designed in prepare(), and the IIR crossovers would glide
+    //to the first block's cutoffs from wherever they were, so hand them the current crossovers first
+    const auto& params = Params::GetParams();
+    for (int i = 0; i < Params::NumCrossovers; ++i)
     {
-        comp.prepare(spec);
+        auto frequency = apvts.getRawParameterValue(params.at(Params::getCrossoverParam(i)))->load();
+        linearPhaseCrossover.setCrossoverFrequency(i, frequency);
+        chain.crossover.setCrossoverFrequency(i, static_cast<SampleType>(frequency));
+        chain.sidechainCrossover.setCrossoverFrequency(i, static_cast<SampleType>(frequency));
     }
 
-    LP1.prepare(spec);
-    HP1.prepare(spec);
-    LP2.prepare(spec);
-    HP2.prepare(spec);
-    AP2.prepare(spec);
+    chain.crossover.prepare(spec);
+
+    linearPhaseCrossover.prepare(spec);
+    setLinearPhase(chain, apvts.getRawParameterValue(params.at(Params::Names::LinearPhase))->load() >= 0.5f);
 
-    inputGain.prepare(spec);
-    outputGain.prepare(spec);
+    //both crossovers start from silence, so there's nothing to fade from
+    crossoverFadePending = false;
 
-    inputGain.setRampDurationSeconds(0.05);
-    outputGain.setRampDurationSeconds(0.05);
+    chain.inputGain.prepare(spec);
+    chain.outputGain.prepare(spec);
 
-    for (auto& buffer : filterBuffers)
+    chain.inputGain.setRampDurationSeconds(0.05);
+    chain.outputGain.setRampDurationSeconds(0.05);
+
+    for (auto& buffer : chain.filterBuffers)
     {
-        buffer.setSize(spec.numChannels, samplesPerBlock);
+        buffer.setSize(static_cast<int>(spec.numChannels), samplesPerBlock);
     }
 
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
+    for (auto& buffer : chain.fadeBuffers)
+    {
+        buffer.setSize(static_cast<int>(spec.numChannels), samplesPerBlock);
+    }
 
-    osc.initialise([](float x) {return std::sin(x); });
-    osc.prepare(spec);
-    osc.setFrequency(getSampleRate() / ((2 << FFTOrder::order2048) - 1) * 50);
+    for (auto& buffer : chain.pathBuffers)
+    {
+        buffer.setSize(static_cast<int>(spec.numChannels), samplesPerBlock);
+    }
 
-    gain.prepare(spec);
-    gain.setGainDecibels(-12.f);
+    //a disabled sidechain bus has no channels, and then nothing is allocated for it
+    auto sidechainChannels = getBusCount(true) > 1 ? getChannelCountOfBus(true, 1) : 0;
+    for (auto& buffer : chain.sidechainBuffers)
+    {
+        buffer.setSize(sidechainChannels, sidechainChannels > 0 ? samplesPerBlock : 0);
+    }
+
+    if (sidechainChannels > 0)
+    {
+        auto sidechainSpec = spec;
+        sidechainSpec.numChannels = static_cast<juce::uint32>(sidechainChannels);
+        chain.sidechainCrossover.prepare(sidechainSpec);
+
+        for (auto& delayLine : chain.sidechainDelays)
+        {
+            delayLine.setMaximumDelayInSamples(linearPhaseCrossover.getLatencySamples());
+            delayLine.prepare(sidechainSpec);
+        }
+    }
+
+    //sets the oversampled dynamics to the current factor's rate
+    setOversampling(chain, juce::roundToInt(apvts.getRawParameterValue(params.at(Params::Names::Oversampling))->load()));
+    setLookahead(chain, apvts.getRawParameterValue(params.at(Params::Names::Lookahead))->load());
+
+    //the groups depend on the bus layout, which can only change while the plugin isn't playing
+    setChannelLink(chain, juce::roundToInt(apvts.getRawParameterValue(params.at(Params::Names::ChannelLink))->load()));
+}
+
+void MBCompAudioProcessor::setNumWorkerThreads(int numThreads)
+{
+    //the audio thread takes a band too, so more threads than that would only wait
+    jassert(numThreads >= 0);
+    workerPool.setNumWorkers(juce::jlimit(0, juce::jmin(Params::NumBands - 1, RealtimeWorkerPool::maxNumWorkers), numThreads));
 }
 
 void MBCompAudioProcessor::releaseResources()
@@ -207,18 +277,25 @@ bool MBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) c
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Mono and stereo, the usual surround and immersive layouts up to 7.1.4,
+    // and discrete buses of as many channels
+    if (!isMainLayoutSupported(layouts.getMainOutputChannelSet()))
         return false;
 
     // This checks if the input layout matches the output layout
    #if ! JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+
+    // The sidechain can be off, mono or stereo whatever the main layout is
+    if (layouts.inputBuses.size() > 1)
+    {
+        auto sidechain = layouts.getChannelSet(true, 1);
+        if (!sidechain.isDisabled()
+         && sidechain != juce::AudioChannelSet::mono()
+         && sidechain != juce::AudioChannelSet::stereo())
+            return false;
+    }
    #endif
 
     return true;
@@ -226,49 +303,321 @@ bool MBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) c
 }
 #endif
 
+bool MBCompAudioProcessor::isMainLayoutSupported(const juce::AudioChannelSet& set)
+{
+    using Set = juce::AudioChannelSet;
+
+    if (set.isDiscreteLayout())
+        return set.size() > 0 && set.size() <= MultiBandCompressor<float>::maxNumChannels;
+
+    static const std::array<Set, 16> layouts
+    {
+        Set::mono(), Set::stereo(), Set::createLCR(), Set::quadraphonic(),
+        Set::create5point0(), Set::create5point1(), Set::create7point0(), Set::create7point1(),
+        Set::create5point0point2(), Set::create5point1point2(), Set::create7point0point2(), Set::create7point1point2(),
+        Set::create5point0point4(), Set::create5point1point4(), Set::create7point0point4(), Set::create7point1point4()
+    };
+
+    return std::find(layouts.begin(), layouts.end(), set) != layouts.end();
+}
+
+std::array<juce::uint32, MultiBandCompressor<float>::maxNumChannels> MBCompAudioProcessor::getChannelLinks(const juce::AudioChannelSet& set, int mode)
+{
+    std::array<juce::uint32, MultiBandCompressor<float>::maxNumChannels> links{};
+    auto numChannels = juce::jmin(set.size(), static_cast<int>(links.size()));
+
+    //0 leaves every channel on its own
+    if (mode == 0 || numChannels < 2)
+        return links;
+
+    if (mode == 2)
+    {
+        links.fill((1u << numChannels) - 1u);
+        return links;
+    }
+
+    //the LFE only carries what bass management sends it, so it's never linked.
+    //a discrete bus has no channel types and is treated as one group
+    enum Group { front, surround, height, lfe };
+
+    auto getGroup = [](juce::AudioChannelSet::ChannelType type)
+    {
+        using T = juce::AudioChannelSet::ChannelType;
+        switch (type)
+        {
+            case T::LFE: case T::LFE2:
+                return lfe;
+            case T::leftSurround: case T::rightSurround: case T::centreSurround:
+            case T::leftSurroundSide: case T::rightSurroundSide:
+            case T::leftSurroundRear: case T::rightSurroundRear:
+                return surround;
+            case T::topMiddle: case T::topFrontLeft: case T::topFrontCentre: case T::topFrontRight:
+            case T::topRearLeft: case T::topRearCentre: case T::topRearRight:
+            case T::topSideLeft: case T::topSideRight:
+                return height;
+            default:
+                return front;
+        }
+    };
+
+    std::array<juce::uint32, 4> groupMasks{};
+    std::array<Group, MultiBandCompressor<float>::maxNumChannels> groups{};
+
+    for (int c = 0; c < numChannels; ++c)
+    {
+        groups[static_cast<size_t>(c)] = getGroup(set.getTypeOfChannel(c));
+        groupMasks[groups[static_cast<size_t>(c)]] |= 1u << c;
+    }
+
+    for (int c = 0; c < numChannels; ++c)
+    {
+        auto group = groups[static_cast<size_t>(c)];
+        links[static_cast<size_t>(c)] = group == lfe ? 0u : groupMasks[group];
+    }
+
+    return links;
+}
+
+std::array<float, LoudnessMeter::maxNumChannels> MBCompAudioProcessor::getLoudnessWeights(const juce::AudioChannelSet& set)
+{
+    std::array<float, LoudnessMeter::maxNumChannels> weights;
+    weights.fill(1.f);
+
+    //a discrete bus has no channel types and weighs every channel the same
+    auto numChannels = juce::jmin(set.size(), static_cast<int>(weights.size()));
+    for (int c = 0; c < numChannels; ++c)
+    {
+        using T = juce::AudioChannelSet::ChannelType;
+        switch (set.getTypeOfChannel(c))
+        {
+            case T::LFE: case T::LFE2:
+                weights[static_cast<size_t>(c)] = 0.f;
+                break;
+            case T::leftSurround: case T::rightSurround:
+            case T::leftSurroundSide: case T::rightSurroundSide:
+                weights[static_cast<size_t>(c)] = 1.41f;
+                break;
+            default:
+                break;
+        }
+    }
+
+    return weights;
+}
+
+template <typename SampleType>
+void MBCompAudioProcessor::setChannelLink(ProcessChain<SampleType>& chain, int mode)
+{
+    auto links = getChannelLinks(getChannelLayoutOfBus(false, 0), mode);
+    chain.multiBandCompressor.setChannelLinks(links);
+    chain.oversampledCompressor.setChannelLinks(links);
+}
+
 void MBCompAudioProcessor::updateState()
 {
-    for (auto& comp : compressors)
+    //only settings whose parameter moved since the last block get recomputed
+    if (!parameters.update())
+        return;
+
+    if (isUsingDoublePrecision())
+        updateChain(doubleChain);
+    else
+        updateChain(floatChain);
+}
+
+template <typename SampleType>
+void MBCompAudioProcessor::updateChain(ProcessChain<SampleType>& chain)
+{
+    using namespace Params;
+
+    for (size_t i = 0; i < compressors.size(); ++i)
+    {
+        compressors[i].updateCompressorSettings(parameters, chain.multiBandCompressor, static_cast<int>(i));
+        compressors[i].updateCompressorSettings(parameters, chain.oversampledCompressor, static_cast<int>(i));
+    }
+
+    for (int i = 0; i < NumCrossovers; ++i)
+    {
+        if (parameters.isDirty(getCrossoverParam(i)))
+        {
+            //both crossovers follow the parameters. the linear phase kernels are only redesigned
+            //while it's on, and a move made while it's off is picked up when it's switched on
+            chain.crossover.setCrossoverFrequency(i, parameters.get(getCrossoverParam(i)));
+            linearPhaseCrossover.setCrossoverFrequency(i, parameters.get(getCrossoverParam(i)));
+            chain.oversampler.setCrossoverFrequency(i, parameters.get(getCrossoverParam(i)));
+            chain.sidechainCrossover.setCrossoverFrequency(i, parameters.get(getCrossoverParam(i)));
+        }
+    }
+
+    if (parameters.isDirty(Names::LinearPhase) && parameters.getBool(Names::LinearPhase) != linearPhase)
+        setLinearPhase(chain, parameters.getBool(Names::LinearPhase));
+
+    if (parameters.isDirty(Names::Oversampling) && parameters.getIndex(Names::Oversampling) != chain.oversampler.getFactorLog2())
+        setOversampling(chain, parameters.getIndex(Names::Oversampling));
+
+    if (parameters.isDirty(Names::Lookahead))
+        setLookahead(chain, parameters.get(Names::Lookahead));
+
+    if (parameters.isDirty(Names::ChannelLink))
+        setChannelLink(chain, parameters.getIndex(Names::ChannelLink));
+
+    if (parameters.isDirty(Names::GainIn))
+        chain.inputGain.setGainDecibels(parameters.get(Names::GainIn));
+
+    if (parameters.isDirty(Names::GainOut))
+        chain.outputGain.setGainDecibels(parameters.get(Names::GainOut));
+}
+
+template <typename SampleType>
+void MBCompAudioProcessor::splitBands(const juce::AudioBuffer<SampleType>& inputBuffer)
+{
+    auto& chain = getChain<SampleType>();
+
+    //the crossover writes each band straight into the preallocated band storage
+    auto numChannels = static_cast<size_t>(juce::jmin(inputBuffer.getNumChannels(), chain.filterBuffers[0].getNumChannels()));
+    auto numSamples = static_cast<size_t>(inputBuffer.getNumSamples());
+    jassert(numSamples <= static_cast<size_t>(chain.filterBuffers[0].getNumSamples()));
+
+    auto inputBlock = juce::dsp::AudioBlock<const SampleType>(inputBuffer).getSubsetChannelBlock(0, numChannels);
+
+    std::array<juce::dsp::AudioBlock<SampleType>, Params::NumBands> bandBlocks, fadeBlocks;
+    for (size_t i = 0; i < bandBlocks.size(); ++i)
+    {
+        bandBlocks[i] = juce::dsp::AudioBlock<SampleType>(chain.filterBuffers[i]).getSubsetChannelBlock(0, numChannels).getSubBlock(0, numSamples);
+        fadeBlocks[i] = juce::dsp::AudioBlock<SampleType>(chain.fadeBuffers[i]).getSubsetChannelBlock(0, numChannels).getSubBlock(0, numSamples);
+    }
+
+    //neither crossover ever restarts from silence when the modes switch. the Linkwitz-Riley tree
+    //is cheap next to the convolution, so it keeps running in linear phase mode. the linear phase
+    //crossover only keeps the recent input while it's off, and catches up from it when it's back on
+    if (linearPhase)
+    {
+        chain.crossover.process(inputBlock, fadeBlocks.data());
+        linearPhaseCrossover.process(inputBlock, bandBlocks.data());
+    }
+    else
+    {
+        if (crossoverFadePending)
+            linearPhaseCrossover.process(inputBlock, fadeBlocks.data());
+        else
+            linearPhaseCrossover.track(inputBlock);
+
+        chain.crossover.process(inputBlock, bandBlocks.data());
+    }
+
+    //the two modes have different latencies, so cutting from one to the other would jump. fading
+    //over the chunk blends the two alignments instead, while the host catches up with the new latency
+    if (crossoverFadePending)
+    {
+        for (size_t i = 0; i < bandBlocks.size(); ++i)
+        {
+            for (size_t c = 0; c < numChannels; ++c)
+            {
+                auto* to = bandBlocks[i].getChannelPointer(c);
+                const auto* from = fadeBlocks[i].getChannelPointer(c);
+
+                for (size_t n = 0; n < numSamples; ++n)
+                {
+                    auto amount = static_cast<SampleType>(n + 1) / static_cast<SampleType>(numSamples);
+                    to[n] = from[n] + (to[n] - from[n]) * amount;
+                }
+            }
+        }
+
+        crossoverFadePending = false;
+    }
+}
+
+template <typename SampleType>
+void MBCompAudioProcessor::splitSidechain(const juce::AudioBuffer<SampleType>& sidechainBuffer)
+{
+    auto& chain = getChain<SampleType>();
+
+    //the keys only set the envelopes, so the Linkwitz-Riley split is used even in linear phase mode:
+    //the band levels are the same, only the phase differs. the latency differs too, so in that mode
+    //the keys are delayed to match. the delays run in both modes, so they're full when it's switched on
+    auto numChannels = static_cast<size_t>(juce::jmin(sidechainBuffer.getNumChannels(), chain.sidechainBuffers[0].getNumChannels()));
+    auto numSamples = static_cast<size_t>(sidechainBuffer.getNumSamples());
+    jassert(numSamples <= static_cast<size_t>(chain.sidechainBuffers[0].getNumSamples()));
+
+    auto inputBlock = juce::dsp::AudioBlock<const SampleType>(sidechainBuffer).getSubsetChannelBlock(0, numChannels);
+
+    std::array<juce::dsp::AudioBlock<SampleType>, Params::NumBands> bandBlocks;
+    for (size_t i = 0; i < bandBlocks.size(); ++i)
+    {
+        bandBlocks[i] = juce::dsp::AudioBlock<SampleType>(chain.sidechainBuffers[i]).getSubsetChannelBlock(0, numChannels).getSubBlock(0, numSamples);
+    }
+
+    chain.sidechainCrossover.process(inputBlock, bandBlocks.data());
+
+    auto keyLatency = static_cast<SampleType>(linearPhase ? linearPhaseCrossover.getLatencySamples() : 0);
+    for (size_t i = 0; i < bandBlocks.size(); ++i)
     {
-        comp.updateCompressorSettings();
+        auto& delayLine = chain.sidechainDelays[i];
+        delayLine.setDelay(keyLatency);
+
+        auto ctx = juce::dsp::ProcessContextReplacing<SampleType>(bandBlocks[i]);
+        delayLine.process(ctx);
     }
+}
+
+//public, so the benchmark tool can time them
+template void MBCompAudioProcessor::splitBands<float>(const juce::AudioBuffer<float>&);
+template void MBCompAudioProcessor::splitBands<double>(const juce::AudioBuffer<double>&);
+template void MBCompAudioProcessor::splitSidechain<float>(const juce::AudioBuffer<float>&);
+template void MBCompAudioProcessor::splitSidechain<double>(const juce::AudioBuffer<double>&);
 
-    auto lowMidCutoff = lowMidCrossover->get();
-    LP1.setCutoffFrequency(lowMidCutoff);
-    HP1.setCutoffFrequency(lowMidCutoff);
+template <typename SampleType>
+void MBCompAudioProcessor::setLinearPhase(ProcessChain<SampleType>& chain, bool shouldBeLinearPhase)
+{
+    linearPhase = shouldBeLinearPhase;
 
-    auto midHighCutoff = midHighCrossover->get();
-    AP2.setCutoffFrequency(midHighCutoff);
-    LP2.setCutoffFrequency(midHighCutoff);
-    HP2.setCutoffFrequency(midHighCutoff);
+    //both crossovers are current whichever mode was on, see splitBands()
+    crossoverFadePending = true;
 
-    inputGain.setGainDecibels(inGainParam->get());
-    outputGain.setGainDecibels(outGainParam->get());
+    updateLatency(chain);
 }
 
-void MBCompAudioProcessor::splitBands(const juce::AudioBuffer<float> &inputBuffer)
+template <typename SampleType>
+void MBCompAudioProcessor::setOversampling(ProcessChain<SampleType>& chain, int factorLog2)
 {
-    for (auto& filterBuffer : filterBuffers)
+    chain.oversampler.setFactorLog2(juce::jlimit(0, BandOversampler<SampleType>::maxFactorLog2, factorLog2));
+
+    //this runs on the audio thread. prepareChain() sized the engine for the highest factor, so
+    //it only recomputes the ballistics for the new rate and never reallocates. the band settings carry over
+    if (chain.oversampler.getFactorLog2() > 0)
     {
-        filterBuffer = inputBuffer;
+        chain.oversampledCompressor.setSampleRate(getSampleRate() * chain.oversampler.getFactor());
+        chain.oversampledCompressor.setLookaheadSamples(chain.multiBandCompressor.getLookaheadSamples() * chain.oversampler.getFactor());
     }
 
-    auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-    auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-    auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
+    updateLatency(chain);
+}
+
+template <typename SampleType>
+void MBCompAudioProcessor::setLookahead(ProcessChain<SampleType>& chain, float lookaheadMs)
+{
+    //rounded at the host rate, so the oversampled bands get exactly the same delay
+    auto numSamples = juce::jmin(juce::roundToInt(lookaheadMs * getSampleRate() / 1000.0),
+                                 chain.multiBandCompressor.getMaxLookaheadSamples());
 
-    auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
-    auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
-    auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
+    //the parameter is dirty on every step of its automation, most of which round to the same count
+    if (numSamples == chain.multiBandCompressor.getLookaheadSamples())
+        return;
 
-    LP1.process(fb0Ctx);
-    AP2.process(fb0Ctx);
+    chain.multiBandCompressor.setLookaheadSamples(numSamples);
 
-    HP1.process(fb1Ctx);
-    filterBuffers[2] = filterBuffers[1];
-    LP2.process(fb1Ctx);
+    if (chain.oversampler.getFactorLog2() > 0)
+        chain.oversampledCompressor.setLookaheadSamples(numSamples * chain.oversampler.getFactor());
 
-    HP2.process(fb2Ctx);
+    updateLatency(chain);
+}
+
+template <typename SampleType>
+void MBCompAudioProcessor::updateLatency(const ProcessChain<SampleType>& chain)
+{
+    auto crossoverLatency = linearPhase ? linearPhaseCrossover.getLatencySamples() : 0;
+    setLatencySamples(crossoverLatency + chain.oversampler.getLatencySamples() + chain.multiBandCompressor.getLookaheadSamples());
 }
 
 void MBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
@@ -297,69 +646,280 @@ void MBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce:
         gain.process(ctx);
     }
 
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
+    processBuffer(buffer);
+}
+
+void MBCompAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    //the same as the float block minus the test tone, with every stage running in double
+    juce::ScopedNoDenormals noDenormals;
+
+    for (auto i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+
+    updateState();
+    processBuffer(buffer);
+}
+
+template <typename SampleType>
+void MBCompAudioProcessor::processBuffer(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& chain = getChain<SampleType>();
+
+    //with a sidechain, 'buffer' also carries the sidechain channels after the main ones.
+    //everything but the keys works on the main bus only
+    auto mainBuffer = getBusBuffer(buffer, false, 0);
+    auto sidechainBuffer = getBusCount(true) > 1 ? getBusBuffer(buffer, true, 1) : juce::AudioBuffer<SampleType>();
+
+    //a disconnected sidechain costs nothing: its crossover isn't run at all
+    auto sidechainChannels = juce::jmin(sidechainBuffer.getNumChannels(), chain.sidechainBuffers[0].getNumChannels());
+    auto useSidechain = sidechainChannels > 0 && parameters.getBool(Params::Names::Sidechain);
+
+    analyzerCapture.update(mainBuffer);
+
+    applyGain(mainBuffer, chain.inputGain);
+
+    auto schedule = scheduleBands();
+
+    auto numSamples = mainBuffer.getNumSamples();
+    auto numChannels = juce::jmin(mainBuffer.getNumChannels(), chain.filterBuffers[0].getNumChannels());
+    auto maxBlockSize = chain.filterBuffers[0].getNumSamples();
+
+    //some hosts send bigger blocks than prepareToPlay() promised. Those get
+    //processed in chunks instead of resizing the band buffers on the audio thread.
+    for (auto start = 0; start < numSamples; start += maxBlockSize)
+    {
+        auto chunkSize = juce::jmin(maxBlockSize, numSamples - start);
+        auto chunk = juce::AudioBuffer<SampleType>(mainBuffer.getArrayOfWritePointers(), numChannels, start, chunkSize);
+
+        if (useSidechain)
+        {
+            auto sidechainChunk = juce::AudioBuffer<SampleType>(sidechainBuffer.getArrayOfWritePointers(), sidechainChannels, start, chunkSize);
+            processBands(chunk, schedule, &sidechainChunk);
+        }
+        else
+        {
+            processBands(chunk, schedule, nullptr);
+        }
+
+        //the band threads have joined by now, so every band's levels are this chunk's
+        TelemetryRecord record;
+        record.numSamples = chunkSize;
+        for (size_t i = 0; i < compressors.size(); ++i)
+        {
+            record.inputLevels[i] = compressors[i].getLinearInputLevel();
+            record.outputLevels[i] = compressors[i].getLinearOutputLevel();
+        }
+
+        telemetry.push(record);
+    }
+
+    applyGain(mainBuffer, chain.outputGain);
 
-    applyGain(buffer, inputGain);
+    loudnessMeter.process(juce::dsp::AudioBlock<const SampleType>(mainBuffer));
+}
 
-    splitBands(buffer);
+MBCompAudioProcessor::BandSchedule MBCompAudioProcessor::scheduleBands() const
+{
+    using namespace Params;
 
-    for (size_t i = 0; i < filterBuffers.size(); ++i)
+    auto isSet = [this](Names name, size_t band)
     {
-        compressors[i].process(filterBuffers[i]);
+        return parameters.getBool(getBandParam(name, static_cast<int>(band)));
+    };
+
+    juce::uint32 soloed = 0, unmuted = 0, active = 0;
+
+    for (size_t i = 0; i < compressors.size(); ++i)
+    {
+        auto bit = 1u << i;
+
+        if (isSet(Names::Solo, i))
+            soloed |= bit;
+
+        if (!isSet(Names::Mute, i))
+            unmuted |= bit;
+
+        if (!isSet(Names::Bypassed, i))
+            active |= bit;
     }
 
+    //soloing overrides muting, as it always has
+    BandSchedule schedule;
+    schedule.audible = soloed != 0 ? soloed : unmuted;
+    schedule.compressed = schedule.audible & active;
+    return schedule;
+}
+
+template <typename SampleType>
+void MBCompAudioProcessor::processBands(juce::AudioBuffer<SampleType>& buffer, const BandSchedule& schedule, const juce::AudioBuffer<SampleType>* sidechain)
+{
+    auto& chain = getChain<SampleType>();
+
     auto numSamples = buffer.getNumSamples();
     auto numChannels = buffer.getNumChannels();
 
-    buffer.clear();
+    //short blocks aren't worth waking anyone for
+    auto parallel = workerPool.getNumWorkers() > 0 && numSamples >= parallelMinBlockSize;
 
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
+    //every band is still split, even the ones nobody hears, so the crossover
+    //states stay continuous and un-muting or un-soloing doesn't click.
+    //the band crossover is one fused tree, but it doesn't share anything with the sidechain's
+    if (sidechain != nullptr && parallel)
     {
-        for (auto i = 0; i < nc; i++)
+        auto split = [this, &buffer, sidechain](int job)
         {
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
-        }
+            if (job == 0)
+                splitBands(buffer);
+            else
+                splitSidechain(*sidechain);
+        };
+
+        workerPool.run(2, split);
+    }
+    else
+    {
+        splitBands(buffer);
+
+        if (sidechain != nullptr)
+            splitSidechain(*sidechain);
+    }
+
+    //views onto the preallocated band storage, sized to this chunk
+    auto getBandBuffer = [nc = numChannels, ns = numSamples](auto& filterBuffer)
+    {
+        return juce::AudioBuffer<SampleType>(filterBuffer.getArrayOfWritePointers(), nc, ns);
     };
 
-    auto solo = false;
-    for (auto& comp : compressors)
+    BandViews<SampleType> views;
+
+    for (size_t i = 0; i < views.buffers.size(); ++i)
+    {
+        views.buffers[i] = getBandBuffer(chain.filterBuffers[i]);
+        views.blocks[i] = juce::dsp::AudioBlock<SampleType>(views.buffers[i]);
+    }
+
+    //the sidechain band with the same index keys each band
+    if (sidechain != nullptr)
     {
-        if (comp.solo->get())
+        auto keyChannels = static_cast<size_t>(sidechain->getNumChannels());
+        for (size_t i = 0; i < views.keyBlocks.size(); ++i)
         {
-            solo = true;
-            break;
+            views.keyBlocks[i] = juce::dsp::AudioBlock<const SampleType>(chain.sidechainBuffers[i]).getSubsetChannelBlock(0, keyChannels)
+                                                                                              .getSubBlock(0, static_cast<size_t>(numSamples));
         }
+
+        views.keys = views.keyBlocks.data();
+    }
+
+    //bands that need it are compressed at the oversampled rate. the rest are delayed to match,
+    //including bypassed and culled ones
+    auto& oversampler = chain.oversampler;
+    oversampler.beginBlock(schedule.audible, numSamples, chain.multiBandCompressor.getLookaheadSamples());
+
+    //a band entering a path picks up its envelopes from the engine it leaves. its lookahead there
+    //starts from silence rather than replaying what it held when the band last left
+    chain.oversampledCompressor.takeEnvelopes(chain.multiBandCompressor, oversampler.getBandsEnteringUpsampled());
+    chain.multiBandCompressor.takeEnvelopes(chain.oversampledCompressor, oversampler.getBandsEnteringDelayed());
+
+    auto moving = oversampler.getMovingBands();
+    for (size_t i = 0; i < views.delayedBlocks.size(); ++i)
+    {
+        views.delayedBlocks[i] = (moving & (1u << i)) != 0
+                                     ? juce::dsp::AudioBlock<SampleType>(chain.pathBuffers[i]).getSubsetChannelBlock(0, static_cast<size_t>(numChannels))
+                                                                                             .getSubBlock(0, static_cast<size_t>(numSamples))
+                                     : views.blocks[i];
     }
 
-    if (solo)
+    constexpr auto allBands = static_cast<juce::uint32>((1u << Params::NumBands) - 1);
+
+    if (parallel)
     {
-        for (size_t i = 0; i < compressors.size(); ++i)
+        auto processBand = [this, &chain, &views, &schedule](int band)
         {
-            auto& comp = compressors[i];
-            if (comp.solo->get())
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
-        }
+            processBandGroup(chain, views, schedule, 1u << band);
+        };
+
+        workerPool.run(Params::NumBands, processBand);
     }
     else
     {
-        for (size_t i = 0; i < compressors.size(); ++i)
+        processBandGroup(chain, views, schedule, allBands);
+    }
+
+    //the first audible band is copied over the input, the rest are added to it
+    auto isFirst = true;
+
+    for (size_t i = 0; i < views.buffers.size(); ++i)
+    {
+        if ((schedule.audible & (1u << i)) == 0)
+            continue;
+
+        for (auto c = 0; c < numChannels; c++)
         {
-            auto& comp = compressors[i];
-            if (!comp.mute->get())
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
+            if (isFirst)
+                buffer.copyFrom(c, 0, views.buffers[i], c, 0, numSamples);
+            else
+                buffer.addFrom(c, 0, views.buffers[i], c, 0, numSamples);
         }
+
+        isFirst = false;
     }
 
-    applyGain(buffer, outputGain);
+    if (isFirst)
+        buffer.clear();
+}
 
-    /*addFilterBand(buffer, filterBuffers[0]);
-    addFilterBand(buffer, filterBuffers[1]);
-    addFilterBand(buffer, filterBuffers[2]);*/
+template <typename SampleType>
+void MBCompAudioProcessor::processBandGroup(ProcessChain<SampleType>& chain, BandViews<SampleType>& views, const BandSchedule& schedule, juce::uint32 group) noexcept
+{
+    auto audible = schedule.audible & group;
+    auto compressed = schedule.compressed & group;
+    auto upsampled = chain.oversampler.getUpsampledBands() & group;
+    auto delayed = chain.oversampler.getDelayedBands() & group;
+    auto moving = upsampled & delayed;
+    auto heardUpsampled = chain.oversampler.getHeardUpsampledBands() & group;
+
+    //a band moving between paths takes both, the delayed one on a copy of its input
+    for (size_t i = 0; i < views.blocks.size(); ++i)
+    {
+        if ((moving & (1u << i)) != 0)
+            views.delayedBlocks[i].copyFrom(views.blocks[i]);
+    }
+
+    if (upsampled != 0)
+    {
+        chain.oversampler.processUp(views.blocks.data(), views.oversampledBlocks.data(), upsampled);
+
+        if (views.keys != nullptr)
+            chain.oversampler.holdKeysUp(views.keys, views.oversampledKeys.data(), compressed & upsampled);
+
+        chain.oversampledCompressor.process(views.oversampledBlocks.data(), compressed & upsampled, upsampled,
+                                            views.keys != nullptr ? views.oversampledKeys.data() : nullptr);
+        chain.oversampler.processDown(views.blocks.data(), upsampled);
+    }
+
+    //culled bands keep their envelopes, exactly like bypassed ones. with lookahead they go through
+    //the host rate engine's delay with the other delayed bands, even though nobody hears them, so a
+    //band that comes back doesn't replay what it held when it was culled
+    chain.multiBandCompressor.process(views.delayedBlocks.data(), compressed & delayed, delayed, views.keys);
+    chain.oversampler.delay(views.delayedBlocks.data(), delayed);
+
+    if (moving != 0)
+        chain.oversampler.mergePaths(views.blocks.data(), views.delayedBlocks.data(), moving);
+
+    for (size_t i = 0; i < views.buffers.size(); ++i)
+    {
+        auto bit = 1u << i;
+
+        //compressed bands were metered by their engine as it applied the gain, at its rate
+        if ((compressed & bit) != 0)
+            compressors[i].updateLevels((heardUpsampled & bit) != 0 ? chain.oversampledCompressor : chain.multiBandCompressor, static_cast<int>(i));
+        else if ((audible & bit) != 0)
+            compressors[i].updateBypassedLevels(views.buffers[i]);
+        else if ((group & bit) != 0)
+            compressors[i].clearLevels();
+    }
 }
 
 //==============================================================================
@@ -394,6 +954,26 @@ void MBCompAudioProcessor::setStateInformation (const void* data, int sizeInByte
     }
 }
 
+std::pair<juce::NormalisableRange<float>, float> MBCompAudioProcessor::getCrossoverRange(int index)
+{
+    using namespace juce;
+
+    //the 3 band build keeps the ranges it has always had
+    if (Params::NumBands == 3)
+    {
+        return index == 0 ? std::make_pair(NormalisableRange<float>(MINFREQ, 999, 1, 1), 400.f)
+                          : std::make_pair(NormalisableRange<float>(1000, MAXFREQ, 1, 1), 2000.f);
+    }
+
+    //otherwise the spectrum is cut into equal slices on a log scale, one per crossover,
+    //so the crossovers can't cross each other. each one defaults to the middle of its slice
+    auto edge = [](int i) { return mapToLog10(static_cast<float>(i) / Params::NumCrossovers, MINFREQ, MAXFREQ); };
+    auto start = std::round(edge(index));
+    auto end = std::round(edge(index + 1)) - (index < Params::NumCrossovers - 1 ? 1.f : 0.f);
+
+    return { NormalisableRange<float>(start, end, 1, 1), std::round(std::sqrt(start * end)) };
+}
+
 juce::AudioProcessorValueTreeState::ParameterLayout MBCompAudioProcessor::createParameterLayout() 
 {
     APVTS::ParameterLayout layout;
@@ -407,44 +987,46 @@ juce::AudioProcessorValueTreeState::ParameterLayout MBCompAudioProcessor::create
     layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::GainOut), params.at(Names::GainOut), gainRange, 0));
 
     auto thresholdRange = NormalisableRange<float>(MINTHRESH, MAXDB, 1, 1);
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::LowThreshold), params.at(Names::LowThreshold), thresholdRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::MidThreshold), params.at(Names::MidThreshold), thresholdRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::HighThreshold), params.at(Names::HighThreshold), thresholdRange, 0));
-
     auto arRange = NormalisableRange<float>(5, 500, 1, 1);
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::LowAttack), params.at(Names::LowAttack), arRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::MidAttack), params.at(Names::MidAttack), arRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::HighAttack), params.at(Names::HighAttack), arRange, 50));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::LowRelease), params.at(Names::LowRelease), arRange, 250));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::MidRelease), params.at(Names::MidRelease), arRange, 250));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::HighRelease), params.at(Names::HighRelease), arRange, 250));
-
-    auto choices = std::vector<double>{ 1, 1.5, 2, 3, 4, 5, 6, 7, 8, 10, 15, 20, 50, 100 };
+
     juce::StringArray sa;
-    for (auto choice : choices) {
+    for (auto choice : Ratios) {
         sa.add(juce::String(choice, 1));
     }
 
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::LowRatio), params.at(Names::LowRatio), sa, 3));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::MidRatio), params.at(Names::MidRatio), sa, 3));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::HighRatio), params.at(Names::HighRatio), sa, 3));
+    //one parameter per band for each of these, added kind by kind like the 3 band layout always was
+    auto addBandParams = [&layout, &params](Names name, auto makeParam)
+    {
+        for (int i = 0; i < NumBands; ++i)
+        {
+            const auto& id = params.at(getBandParam(name, i));
+            layout.add(makeParam(id));
+        }
+    };
 
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::LowBypassed), params.at(Names::LowBypassed), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::MidBypassed), params.at(Names::MidBypassed), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::HighBypassed), params.at(Names::HighBypassed), false));
+    addBandParams(Names::Threshold, [&](const String& id) { return std::make_unique<AudioParameterFloat>(id, id, thresholdRange, 0); });
+    addBandParams(Names::Attack, [&](const String& id) { return std::make_unique<AudioParameterFloat>(id, id, arRange, 50); });
+    addBandParams(Names::Release, [&](const String& id) { return std::make_unique<AudioParameterFloat>(id, id, arRange, 250); });
+    addBandParams(Names::Ratio, [&](const String& id) { return std::make_unique<AudioParameterChoice>(id, id, sa, 3); });
+    addBandParams(Names::Bypassed, [](const String& id) { return std::make_unique<AudioParameterBool>(id, id, false); });
+    addBandParams(Names::Mute, [](const String& id) { return std::make_unique<AudioParameterBool>(id, id, false); });
+    addBandParams(Names::Solo, [](const String& id) { return std::make_unique<AudioParameterBool>(id, id, false); });
 
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::LowMute), params.at(Names::LowMute), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::MidMute), params.at(Names::MidMute), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::HighMute), params.at(Names::HighMute), false));
+    for (int i = 0; i < NumCrossovers; ++i)
+    {
+        const auto& id = params.at(getCrossoverParam(i));
+        auto [range, defaultValue] = getCrossoverRange(i);
+        layout.add(std::make_unique<AudioParameterFloat>(id, id, range, defaultValue));
+    }
 
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::LowSolo), params.at(Names::LowSolo), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::MidSolo), params.at(Names::MidSolo), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::HighSolo), params.at(Names::HighSolo), false));
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::LinearPhase), params.at(Names::LinearPhase), false));
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Oversampling), params.at(Names::Oversampling), OversamplingChoices, 0));
 
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::LowMidCrossoverFreq),params.at(Names::LowMidCrossoverFreq), NormalisableRange<float>(MINFREQ, 999, 1, 1), 400));
+    auto lookaheadRange = NormalisableRange<float>(0.f, static_cast<float>(MultiBandCompressor<float>::maxLookaheadMs), 0.1f, 1.f);
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Lookahead), params.at(Names::Lookahead), lookaheadRange, 0));
 
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::MidHighCrossoverFreq), params.at(Names::MidHighCrossoverFreq), NormalisableRange<float>(1000, MAXFREQ, 1, 1), 2000));
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Sidechain), params.at(Names::Sidechain), false));
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::ChannelLink), params.at(Names::ChannelLink), ChannelLinkChoices, 0));
 
     return layout;
 }
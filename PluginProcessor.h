@@ -10,7 +10,14 @@
 
 #include <JuceHeader.h>
 #include "DSP/CompressorBand.h"
-#include "DSP/SingleChannelSampleFifo.h"
+#include "DSP/Params.h"
+#include "DSP/LinkwitzRileyCrossover.h"
+#include "DSP/LinearPhaseCrossover.h"
+#include "DSP/BandOversampler.h"
+#include "DSP/RealtimeWorkerPool.h"
+#include "DSP/LoudnessMeter.h"
+#include "DSP/TelemetryRing.h"
+#include "DSP/AnalyzerCaptureRing.h"
 
 //==============================================================================
 /**
@@ -34,6 +41,10 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    //every stage runs in double too, so a 64-bit host doesn't convert each block to float and back
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -61,41 +72,198 @@ public:
     using APVTS = juce::AudioProcessorValueTreeState;
     static APVTS::ParameterLayout createParameterLayout();
 
+    //range and default of crossover 'index', lowest first
+    static std::pair<juce::NormalisableRange<float>, float> getCrossoverRange(int index);
+
+    //main bus layouts the plugin runs on: mono to 7.1.4, and discrete buses of as many channels as the dynamics take
+    static bool isMainLayoutSupported(const juce::AudioChannelSet& set);
+
+    //the MultiBandCompressor channel links for 'mode' (a ChannelLinkChoices index) on 'set'
+    static std::array<juce::uint32, MultiBandCompressor<float>::maxNumChannels> getChannelLinks(const juce::AudioChannelSet& set, int mode);
+
+    //the BS.1770 weight of each channel of 'set': 0 for the LFE, 1.41 for the side surrounds, 1 for the rest
+    static std::array<float, LoudnessMeter::maxNumChannels> getLoudnessWeights(const juce::AudioChannelSet& set);
+
     APVTS apvts{ *this, nullptr, "Parameters", createParameterLayout() };
 
-    using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo{ Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo{ Channel::Right };
+    //the main bus as the analyzers see it, written once per block
+    AnalyzerCaptureRing analyzerCapture;
+
+    //one per band, lowest first. the band count is set at compile time with MBCOMP_NUM_BANDS
+    std::array<CompressorBand, Params::NumBands> compressors;
+
+    //public so the benchmark tool can time each stage on its own
+    void updateState();
+
+    //float or double, whichever the processor was prepared for
+    template <typename SampleType>
+    void splitBands(const juce::AudioBuffer<SampleType>& inputBuffer);
+
+    //splits the sidechain input into the same bands, to key each band's compressor
+    template <typename SampleType>
+    void splitSidechain(const juce::AudioBuffer<SampleType>& sidechainBuffer);
+
+    template <typename SampleType = float>
+    const juce::AudioBuffer<SampleType>& getFilterBuffer(size_t band) const { return getChain<SampleType>().filterBuffers[band]; }
+
+    //blocks this long or longer run each band on its own thread, when there are workers
+    static constexpr int parallelMinBlockSize = 1024;
+
+    //threads that help the audio thread with the bands of long blocks, at most one less than the bands.
+    //0, the default, keeps everything on the audio thread. starts threads, so call it before prepareToPlay()
+    void setNumWorkerThreads(int numThreads);
+    int getNumWorkerThreads() const { return workerPool.getNumWorkers(); }
 
-    std::array<CompressorBand, 3> compressors;
-    CompressorBand& lowBandComp = compressors[0];
-    CompressorBand& midBandComp = compressors[1];
-    CompressorBand& highBandComp = compressors[2];
+    //loudness and true peak of the output. one thread reads it, the editor or the renderer
+    LoudnessMeter loudnessMeter;
+
+    //every band's linear RMS levels over one processed chunk
+    struct TelemetryRecord
+    {
+        int numSamples = 0;
+        std::array<float, Params::NumBands> inputLevels{};
+        std::array<float, Params::NumBands> outputLevels{};
+
+        //in dB, 0 for a silent band
+        float getGainReduction(size_t band) const
+        {
+            return inputLevels[band] > 0.f ? juce::Decibels::gainToDecibels(outputLevels[band] / inputLevels[band]) : 0.f;
+        }
+    };
+
+    //a record per chunk, for the editor to drain. a second of 64 sample blocks at 48 kHz fits
+    static constexpr int telemetryCapacity = 1024;
+    TelemetryRing<TelemetryRecord, telemetryCapacity> telemetry;
 
 private:
-    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-    Filter LP1, AP2, HP1, LP2, HP2;
+    //every stage on the signal path, in one sample type. the host picks float or
+    //double before prepareToPlay(), and only that chain is prepared and run
+    template <typename SampleType>
+    struct ProcessChain
+    {
+        LinkwitzRileyCrossover<SampleType> crossover;
+        MultiBandCompressor<SampleType> multiBandCompressor;
+
+        //the dynamics of the bands that are oversampled, running at the oversampled rate
+        BandOversampler<SampleType> oversampler;
+        MultiBandCompressor<SampleType> oversampledCompressor;
+
+        std::array<juce::AudioBuffer<SampleType>, Params::NumBands> filterBuffers;
 
-    juce::AudioParameterFloat* lowMidCrossover{ nullptr };
-    juce::AudioParameterFloat* midHighCrossover{ nullptr };
-    
-    std::array<juce::AudioBuffer<float>, 3> filterBuffers;
+        //what the crossover that isn't heard splits the input into, to fade from when the modes switch
+        std::array<juce::AudioBuffer<SampleType>, Params::NumBands> fadeBuffers;
+
+        //the delayed path of a band moving between paths, see BandOversampler::mergePaths()
+        std::array<juce::AudioBuffer<SampleType>, Params::NumBands> pathBuffers;
+
+        //only prepared and run while the sidechain bus is enabled
+        LinkwitzRileyCrossover<SampleType> sidechainCrossover;
+        std::array<juce::AudioBuffer<SampleType>, Params::NumBands> sidechainBuffers;
+
+        //hold the keys back by the linear phase crossover's latency, so they line up with the bands
+        std::array<juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None>, Params::NumBands> sidechainDelays;
+
+        juce::dsp::Gain<SampleType> inputGain, outputGain;
+    };
+
+    ProcessChain<float> floatChain;
+    ProcessChain<double> doubleChain;
+
+    template <typename SampleType>
+    ProcessChain<SampleType>& getChain() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleChain;
+        else
+            return floatChain;
+    }
+
+    template <typename SampleType>
+    const ProcessChain<SampleType>& getChain() const noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleChain;
+        else
+            return floatChain;
+    }
+
+    ParameterSnapshot parameters;
+
+    //float inside, whatever the chain's sample type. see LinearPhaseCrossover::process()
+    LinearPhaseCrossover linearPhaseCrossover;
+    bool linearPhase = false;
+
+    //the next chunk fades from the other crossover's bands to this mode's
+    bool crossoverFadePending = false;
+
+    RealtimeWorkerPool workerPool;
 
-    juce::dsp::Gain<float> inputGain, outputGain;
     juce::AudioParameterFloat* inGainParam{ nullptr };
     juce::AudioParameterFloat* outGainParam{ nullptr };
 
-    template<typename T, typename U>
-    void applyGain(T& buffer, U& gain)
+    //which bands are heard this block, and which of those go through the compressor
+    struct BandSchedule
     {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        gain.process(ctx);
-    }
+        juce::uint32 audible = 0;
+        juce::uint32 compressed = 0;
+    };
 
-    void updateState();
+    template <typename SampleType>
+    void prepareChain(ProcessChain<SampleType>& chain, const juce::dsp::ProcessSpec& spec);
+
+    //pushes the settings that changed in 'parameters' to 'chain'
+    template <typename SampleType>
+    void updateChain(ProcessChain<SampleType>& chain);
 
-    void splitBands(const juce::AudioBuffer<float>& inputBuffer);
+    //switches crossover, fading over the next chunk, and reports the new latency to the host
+    template <typename SampleType>
+    void setLinearPhase(ProcessChain<SampleType>& chain, bool shouldBeLinearPhase);
+    template <typename SampleType>
+    void setOversampling(ProcessChain<SampleType>& chain, int factorLog2);
+    template <typename SampleType>
+    void setLookahead(ProcessChain<SampleType>& chain, float lookaheadMs);
+    template <typename SampleType>
+    void updateLatency(const ProcessChain<SampleType>& chain);
+
+    //the detector links for 'mode' (a ChannelLinkChoices index) on the main bus layout
+    template <typename SampleType>
+    void setChannelLink(ProcessChain<SampleType>& chain, int mode);
+
+    //everything after updateState(), for either processBlock()
+    template <typename SampleType>
+    void processBuffer(juce::AudioBuffer<SampleType>& buffer);
+
+    //views onto one chunk of the band storage, shared by every band group of processBands()
+    template <typename SampleType>
+    struct BandViews
+    {
+        std::array<juce::AudioBuffer<SampleType>, Params::NumBands> buffers;
+        std::array<juce::dsp::AudioBlock<SampleType>, Params::NumBands> blocks, oversampledBlocks;
+        std::array<juce::dsp::AudioBlock<const SampleType>, Params::NumBands> keyBlocks, oversampledKeys;
+
+        //where each band's delayed path runs: blocks[band], or a copy of it while the band is moving between paths
+        std::array<juce::dsp::AudioBlock<SampleType>, Params::NumBands> delayedBlocks;
+
+        //null unless the bands are keyed off the sidechain bus
+        const juce::dsp::AudioBlock<const SampleType>* keys = nullptr;
+    };
+
+    BandSchedule scheduleBands() const;
+    //'sidechain' is null unless the bands are keyed off the sidechain bus
+    template <typename SampleType>
+    void processBands(juce::AudioBuffer<SampleType>& buffer, const BandSchedule& schedule, const juce::AudioBuffer<SampleType>* sidechain);
+
+    //meters, dynamics and latency matching for the bands in 'group'. groups that don't share a band can run at once
+    template <typename SampleType>
+    void processBandGroup(ProcessChain<SampleType>& chain, BandViews<SampleType>& views, const BandSchedule& schedule, juce::uint32 group) noexcept;
+
+    template<typename SampleType, typename U>
+    void applyGain(juce::AudioBuffer<SampleType>& buffer, U& gain)
+    {
+        auto block = juce::dsp::AudioBlock<SampleType>(buffer);
+        auto ctx = juce::dsp::ProcessContextReplacing<SampleType>(block);
+        gain.process(ctx);
+    }
 
     juce::dsp::Oscillator<float> osc;
     juce::dsp::Gain<float> gain;
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.cpp
+    Created: 18 Oct 2026 10:31:52pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include <numeric>
+#include "BatchRenderer.h"
+
+juce::var BatchWorkerStats::toVar(double batchWallSeconds) const
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("files", filesRendered);
+    obj->setProperty("stolen", filesStolen);
+    obj->setProperty("dspSeconds", dspSeconds);
+    obj->setProperty("activeSeconds", activeSeconds);
+    //share of the batch's wall time this worker spent in processBlock, and on a file at all
+    obj->setProperty("dspUtilisation", batchWallSeconds > 0.0 ? dspSeconds / batchWallSeconds : 0.0);
+    obj->setProperty("utilisation", batchWallSeconds > 0.0 ? activeSeconds / batchWallSeconds : 0.0);
+
+    return juce::var(obj);
+}
+
+juce::var BatchStats::toVar() const
+{
+    juce::Array<juce::var> workerReports;
+    for (const auto& worker : workers)
+    {
+        workerReports.add(worker.toVar(wallSeconds));
+    }
+
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("numWorkers", static_cast<int>(workers.size()));
+    obj->setProperty("wallSeconds", wallSeconds);
+    obj->setProperty("workers", workerReports);
+
+    return juce::var(obj);
+}
+
+BatchRenderer::Worker::Worker(BatchRenderer& owner, int workerIndex)
+    : juce::Thread("MBComp Batch Worker " + juce::String(workerIndex)),
+      batch(owner),
+      index(workerIndex),
+      ioThread("MBComp Batch I/O " + juce::String(workerIndex))
+{
+}
+
+void BatchRenderer::Worker::run()
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    for (;;)
+    {
+        auto stolen = false;
+        auto file = batch.takeFile(index, stolen);
+
+        if (file < 0 || threadShouldExit())
+            return;
+
+        auto start = juce::Time::getHighResolutionTicks();
+
+        auto& fileStats = batch.fileStats[static_cast<size_t>(file)];
+        auto result = batch.renderer.renderFile(batch.files.getReference(file), fileStats, processor, &ioThread);
+        batch.fileResults[static_cast<size_t>(file)] = result;
+
+        stats.activeSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        if (result.wasOk())
+        {
+            ++stats.filesRendered;
+            stats.dspSeconds += fileStats.dspSeconds;
+
+            if (stolen)
+                ++stats.filesStolen;
+        }
+    }
+}
+
+BatchRenderer::BatchRenderer(OfflineRenderer& r, int numWorkers) : renderer(r)
+{
+    if (numWorkers <= 0)
+        numWorkers = juce::SystemStats::getNumCpus();
+
+    //the processors are built here, on the caller's thread, like a host would
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>(*this, i));
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+}
+
+BatchRenderer::~BatchRenderer()
+{
+    for (auto& worker : workers)
+    {
+        worker->stopThread(-1);
+        worker->ioThread.stopThread(1000);
+    }
+}
+
+BatchStats BatchRenderer::render(const juce::Array<juce::File>& inputFiles)
+{
+    files = inputFiles;
+    fileStats.assign(static_cast<size_t>(files.size()), RenderStats());
+    fileResults.assign(static_cast<size_t>(files.size()), juce::Result::ok());
+
+    //largest first, so no worker picks up a long file right at the end
+    std::vector<int> order(static_cast<size_t>(files.size()));
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b)
+    {
+        return files.getReference(a).getSize() > files.getReference(b).getSize();
+    });
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        queues[i % queues.size()]->files.push_back(order[i]);
+    }
+
+    auto start = juce::Time::getHighResolutionTicks();
+
+    for (auto& worker : workers)
+    {
+        worker->stats = {};
+        worker->ioThread.startThread();
+        worker->startThread();
+    }
+
+    for (auto& worker : workers)
+    {
+        worker->waitForThreadToExit(-1);
+        worker->ioThread.stopThread(1000);
+    }
+
+    BatchStats stats;
+    stats.wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+    for (size_t i = 0; i < fileResults.size(); ++i)
+    {
+        if (fileResults[i].wasOk())
+            stats.files.push_back(fileStats[i]);
+        else
+            stats.errors.add(fileResults[i].getErrorMessage());
+    }
+
+    for (const auto& worker : workers)
+    {
+        stats.workers.push_back(worker->stats);
+    }
+
+    return stats;
+}
+
+int BatchRenderer::takeFile(int worker, bool& stolen)
+{
+    {
+        auto& own = *queues[static_cast<size_t>(worker)];
+        const juce::ScopedLock sl(own.lock);
+
+        if (!own.files.empty())
+        {
+            auto file = own.files.front();
+            own.files.pop_front();
+            stolen = false;
+            return file;
+        }
+    }
+
+    //the back of a queue holds its smallest file, which evens out the tail best
+    auto numQueues = static_cast<int>(queues.size());
+    for (int i = 1; i < numQueues; ++i)
+    {
+        auto& victim = *queues[static_cast<size_t>((worker + i) % numQueues)];
+        const juce::ScopedLock sl(victim.lock);
+
+        if (!victim.files.empty())
+        {
+            auto file = victim.files.back();
+            victim.files.pop_back();
+            stolen = true;
+            return file;
+        }
+    }
+
+    return -1;
+}
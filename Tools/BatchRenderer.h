@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.h
+    Created: 18 Oct 2026 10:31:52pm
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+
+struct BatchWorkerStats
+{
+    int filesRendered = 0;
+    int filesStolen = 0;         //taken from another worker's queue
+
+    double dspSeconds = 0.0;     //time spent inside processBlock
+    double activeSeconds = 0.0;  //time spent on a file, including waits on decode/encode
+
+    juce::var toVar(double batchWallSeconds) const;
+};
+
+struct BatchStats
+{
+    //in the order the files were given
+    std::vector<RenderStats> files;
+    juce::StringArray errors;
+
+    std::vector<BatchWorkerStats> workers;
+    double wallSeconds = 0.0;
+
+    juce::var toVar() const;
+};
+
+/*
+ Renders many files at once, one MBCompAudioProcessor per worker thread.
+
+ The files are dealt out largest first, round robin, into one queue per
+ worker. A worker takes from the front of its own queue, and once that's
+ empty steals from the back of another's, so the big files start early
+ and the small ones fill in the gaps at the end. Every worker has an I/O
+ thread that decodes ahead of and encodes behind its processor.
+ */
+class BatchRenderer
+{
+public:
+    //0 workers is one per CPU
+    BatchRenderer(OfflineRenderer& renderer, int numWorkers);
+    ~BatchRenderer();
+
+    BatchStats render(const juce::Array<juce::File>& inputFiles);
+
+    int getNumWorkers() const { return static_cast<int>(workers.size()); }
+private:
+    struct Worker : juce::Thread
+    {
+        Worker(BatchRenderer& owner, int index);
+        void run() override;
+
+        BatchRenderer& batch;
+        const int index;
+
+        MBCompAudioProcessor processor;
+        juce::TimeSliceThread ioThread;
+
+        BatchWorkerStats stats;
+    };
+
+    struct WorkQueue
+    {
+        juce::CriticalSection lock;
+        std::deque<int> files;
+    };
+
+    OfflineRenderer& renderer;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    //for the batch being rendered, indexed like the input files
+    juce::Array<juce::File> files;
+    std::vector<RenderStats> fileStats;
+    std::vector<juce::Result> fileResults;
+
+    //the next file for 'worker', or -1 once every queue is empty
+    int takeFile(int worker, bool& stolen);
+};
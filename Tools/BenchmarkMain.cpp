@@ -0,0 +1,1217 @@
+/*
+  ==============================================================================
+
+    BenchmarkMain.cpp
+    Created: 18 Oct 2026 11:38:20am
+    Author:  Aidan
+
+    Times each DSP stage of MBCompAudioProcessor on its own over a sweep of
+    block sizes, sample rates and channel layouts and writes the results as
+    JSON. Build it as a JUCE console application with the plugin sources.
+
+    MBCompBenchmark [--output=bench.json] [--seconds=1.0] [--stage=splitBands]
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "../PluginProcessor.h"
+#include "../GUI/FFTDataGenerator.h"
+#include "../GUI/PathProducer.h"
+#include "../DSP/Params.h"
+#include "../DSP/SingleChannelSampleFifo.h"
+
+struct BenchConfig
+{
+    double sampleRate = 48000.0;
+    int blockSize = 512;
+    int numChannels = 2;
+};
+
+struct BenchResult
+{
+    juce::String stage;
+    BenchConfig config;
+    int iterations = 0;
+    double seconds = 0.0;
+    double copyBytesPerBlock = 0.0;
+    double maxAbsError = -1.0;
+    int numBands = 0;
+    //serial time over this stage's time, for stages that run on worker threads
+    double speedup = -1.0;
+    int numWorkerThreads = 0;
+
+    double getNsPerBlock() const { return iterations > 0 ? seconds * 1.0e9 / iterations : 0.0; }
+    double getNsPerSample() const { return getNsPerBlock() / config.blockSize; }
+    //what to compare across channel counts
+    double getNsPerChannelSample() const { return getNsPerSample() / config.numChannels; }
+    double getNsPerBandSample() const { return numBands > 0 ? getNsPerSample() / numBands : 0.0; }
+    //share of the real-time budget one block of this stage uses
+    double getCpuPercent() const { return getNsPerBlock() / (config.blockSize / config.sampleRate * 1.0e9) * 100.0; }
+
+    juce::var toVar() const
+    {
+        auto* obj = new juce::DynamicObject();
+        obj->setProperty("stage", stage);
+        obj->setProperty("sampleRate", config.sampleRate);
+        obj->setProperty("blockSize", config.blockSize);
+        obj->setProperty("numChannels", config.numChannels);
+        obj->setProperty("iterations", iterations);
+        obj->setProperty("nsPerBlock", getNsPerBlock());
+        obj->setProperty("nsPerSample", getNsPerSample());
+        obj->setProperty("nsPerChannelSample", getNsPerChannelSample());
+        obj->setProperty("cpuPercent", getCpuPercent());
+        if (maxAbsError >= 0.0)
+            obj->setProperty("maxAbsError", maxAbsError);
+        if (speedup >= 0.0)
+        {
+            obj->setProperty("speedup", speedup);
+            obj->setProperty("numWorkerThreads", numWorkerThreads);
+        }
+        if (numBands > 0)
+        {
+            obj->setProperty("numBands", numBands);
+            obj->setProperty("nsPerBandSample", getNsPerBandSample());
+        }
+        if (copyBytesPerBlock > 0.0)
+        {
+            obj->setProperty("copyBytesPerBlock", copyBytesPerBlock);
+            obj->setProperty("copyGBPerSecond", copyBytesPerBlock * iterations / seconds / 1.0e9);
+        }
+        return juce::var(obj);
+    }
+};
+
+static double audioSecondsPerCase = 1.0;
+
+static int getNumIterations(const BenchConfig& config)
+{
+    return juce::jmax(16, juce::roundToInt(audioSecondsPerCase * config.sampleRate / config.blockSize));
+}
+
+template <typename Fn>
+static double timeIterations(int iterations, Fn&& fn)
+{
+    auto start = juce::Time::getHighResolutionTicks();
+    for (int i = 0; i < iterations; ++i)
+    {
+        fn();
+    }
+    return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+}
+
+static void fillWithNoise(juce::AudioBuffer<float>& buffer)
+{
+    juce::Random random(0x4d42);
+    for (int c = 0; c < buffer.getNumChannels(); ++c)
+    {
+        auto* data = buffer.getWritePointer(c);
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            data[i] = random.nextFloat() - 0.5f;
+        }
+    }
+}
+
+static juce::dsp::ProcessSpec makeSpec(const BenchConfig& config)
+{
+    return { config.sampleRate,
+             static_cast<juce::uint32>(config.blockSize),
+             static_cast<juce::uint32>(config.numChannels) };
+}
+
+//the immersive layouts for the channel counts they use, so their channel types (and link groups) are real
+static juce::AudioChannelSet getChannelSetFor(int numChannels)
+{
+    if (numChannels == 10)
+        return juce::AudioChannelSet::create7point1point2();
+
+    if (numChannels == 12)
+        return juce::AudioChannelSet::create7point1point4();
+
+    return juce::AudioChannelSet::canonicalChannelSet(numChannels);
+}
+
+static std::unique_ptr<MBCompAudioProcessor> makeProcessor(const BenchConfig& config, int sidechainChannels = 0,
+                                                           juce::AudioProcessor::ProcessingPrecision precision = juce::AudioProcessor::singlePrecision,
+                                                           int numWorkerThreads = 0)
+{
+    auto processor = std::make_unique<MBCompAudioProcessor>();
+
+    auto channelSet = getChannelSetFor(config.numChannels);
+    auto layout = processor->getBusesLayout();
+    layout.getChannelSet(true, 0) = channelSet;
+    layout.getChannelSet(false, 0) = channelSet;
+    layout.getChannelSet(true, 1) = sidechainChannels > 0 ? juce::AudioChannelSet::canonicalChannelSet(sidechainChannels)
+                                                          : juce::AudioChannelSet::disabled();
+    processor->setBusesLayout(layout);
+
+    processor->setNonRealtime(true);
+    processor->setProcessingPrecision(precision);
+    processor->setNumWorkerThreads(numWorkerThreads);
+    processor->setRateAndBufferSizeDetails(config.sampleRate, config.blockSize);
+    processor->prepareToPlay(config.sampleRate, config.blockSize);
+    processor->updateState();
+
+    return processor;
+}
+
+/*
+ the crossover as it was before LinkwitzRileyCrossover: separate
+ juce::dsp::LinkwitzRileyFilter passes (LP1 -> AP2, HP1 -> LP2 / HP2 for
+ three bands, the same tree for N). Used as the timing baseline and as
+ the reference the fused crossover's output is checked against.
+ */
+struct ReferenceCrossover
+{
+    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
+
+    //per crossover: a lowpass and a highpass, plus one allpass for every band below it
+    std::vector<Filter> lowpasses, highpasses;
+    std::vector<std::vector<Filter>> allpasses;
+    std::vector<juce::AudioBuffer<float>> filterBuffers;
+
+    void prepare(const BenchConfig& config, const std::vector<float>& cutoffs)
+    {
+        juce::dsp::ProcessSpec spec{ config.sampleRate,
+                                     static_cast<juce::uint32>(config.blockSize),
+                                     static_cast<juce::uint32>(config.numChannels) };
+
+        auto numCrossovers = cutoffs.size();
+        lowpasses.resize(numCrossovers);
+        highpasses.resize(numCrossovers);
+        allpasses.resize(numCrossovers);
+
+        auto prepareFilter = [&spec](Filter& filter, juce::dsp::LinkwitzRileyFilterType type, float cutoff)
+        {
+            filter.setType(type);
+            filter.prepare(spec);
+            filter.setCutoffFrequency(cutoff);
+        };
+
+        for (size_t i = 0; i < numCrossovers; ++i)
+        {
+            prepareFilter(lowpasses[i], juce::dsp::LinkwitzRileyFilterType::lowpass, cutoffs[i]);
+            prepareFilter(highpasses[i], juce::dsp::LinkwitzRileyFilterType::highpass, cutoffs[i]);
+
+            allpasses[i] = std::vector<Filter>(i);
+            for (auto& allpass : allpasses[i])
+            {
+                prepareFilter(allpass, juce::dsp::LinkwitzRileyFilterType::allpass, cutoffs[i]);
+            }
+        }
+
+        filterBuffers.resize(numCrossovers + 1);
+        for (auto& buffer : filterBuffers)
+        {
+            buffer.setSize(config.numChannels, config.blockSize);
+        }
+    }
+
+    void process(const juce::AudioBuffer<float>& input)
+    {
+        auto numCrossovers = lowpasses.size();
+        filterBuffers.back().makeCopyOf(input, true);
+
+        //the top buffer carries what is left above the crossovers split off so far
+        auto remainder = juce::dsp::AudioBlock<float>(filterBuffers.back());
+
+        for (size_t i = 0; i < numCrossovers; ++i)
+        {
+            auto band = juce::dsp::AudioBlock<float>(filterBuffers[i]);
+            lowpasses[i].process(juce::dsp::ProcessContextNonReplacing<float>(remainder, band));
+            highpasses[i].process(juce::dsp::ProcessContextReplacing<float>(remainder));
+
+            for (size_t b = 0; b < i; ++b)
+            {
+                auto lowerBand = juce::dsp::AudioBlock<float>(filterBuffers[b]);
+                allpasses[i][b].process(juce::dsp::ProcessContextReplacing<float>(lowerBand));
+            }
+        }
+    }
+};
+
+//the crossover frequencies makeProcessor() leaves the processor on, i.e. the parameter defaults
+static std::vector<float> getDefaultCutoffs()
+{
+    std::vector<float> cutoffs;
+    for (int i = 0; i < Params::NumCrossovers; ++i)
+    {
+        cutoffs.push_back(MBCompAudioProcessor::getCrossoverRange(i).second);
+    }
+    return cutoffs;
+}
+
+static void prepareReference(ReferenceCrossover& reference, const BenchConfig& config)
+{
+    reference.prepare(config, getDefaultCutoffs());
+}
+
+//==============================================================================
+static BenchResult benchSplitBands(const BenchConfig& config)
+{
+    auto processor = makeProcessor(config);
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+
+    BenchResult result{ "splitBands", config, getNumIterations(config) };
+
+    //check the fused crossover against the five-filter reference on fresh noise every block
+    {
+        ReferenceCrossover reference;
+        prepareReference(reference, config);
+
+        juce::Random random(0x4d42);
+        auto maxError = 0.f;
+
+        for (int i = 0; i < result.iterations; ++i)
+        {
+            for (int c = 0; c < config.numChannels; ++c)
+            {
+                for (int n = 0; n < config.blockSize; ++n)
+                {
+                    buffer.setSample(c, n, random.nextFloat() - 0.5f);
+                }
+            }
+
+            processor->splitBands(buffer);
+            reference.process(buffer);
+
+            for (size_t b = 0; b < reference.filterBuffers.size(); ++b)
+            {
+                const auto& bandBuffer = processor->getFilterBuffer(b);
+                for (int c = 0; c < config.numChannels; ++c)
+                {
+                    for (int n = 0; n < config.blockSize; ++n)
+                    {
+                        maxError = juce::jmax(maxError, std::abs(bandBuffer.getSample(c, n) - reference.filterBuffers[b].getSample(c, n)));
+                    }
+                }
+            }
+        }
+
+        result.maxAbsError = maxError;
+    }
+
+    fillWithNoise(buffer);
+    result.seconds = timeIterations(result.iterations, [&] { processor->splitBands(buffer); });
+    return result;
+}
+
+static BenchResult benchReferenceCrossover(const BenchConfig& config)
+{
+    ReferenceCrossover reference;
+    prepareReference(reference, config);
+
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    fillWithNoise(buffer);
+
+    BenchResult result{ "referenceCrossover", config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&] { reference.process(buffer); });
+    return result;
+}
+
+static BenchResult runCrossoverSweep(const juce::String& stage, const BenchConfig& config, double smoothingSeconds)
+{
+    //automation moving every crossover on every block, up and down an octave around its default
+    LinkwitzRileyCrossover<float> crossover;
+    crossover.setNumBands(Params::NumBands);
+    crossover.setSmoothing(smoothingSeconds, LinkwitzRileyCrossover<float>::defaultControlInterval);
+
+    auto cutoffs = getDefaultCutoffs();
+    for (size_t i = 0; i < cutoffs.size(); ++i)
+    {
+        crossover.setCrossoverFrequency(static_cast<int>(i), cutoffs[i]);
+    }
+
+    crossover.prepare(makeSpec(config));
+
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    fillWithNoise(buffer);
+
+    std::vector<juce::AudioBuffer<float>> bands(Params::NumBands);
+    std::vector<juce::dsp::AudioBlock<float>> blocks;
+    for (auto& band : bands)
+    {
+        band.setSize(config.numChannels, config.blockSize);
+        blocks.emplace_back(band);
+    }
+
+    auto inputBlock = juce::dsp::AudioBlock<const float>(buffer);
+    auto maxCutoff = static_cast<float>(0.45 * config.sampleRate);
+    auto block = 0;
+
+    BenchResult result{ stage, config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        auto octave = std::sin(0.05f * static_cast<float>(block++));
+        for (size_t i = 0; i < cutoffs.size(); ++i)
+        {
+            crossover.setCrossoverFrequency(static_cast<int>(i), juce::jmin(maxCutoff, cutoffs[i] * std::exp2(octave)));
+        }
+
+        crossover.process(inputBlock, blocks.data());
+    });
+    return result;
+}
+
+static BenchResult benchCrossoverSweep(const BenchConfig& config)
+{
+    return runCrossoverSweep("crossoverSweep", config, LinkwitzRileyCrossover<float>::defaultSmoothingSeconds);
+}
+
+static BenchResult benchLegacyCrossoverSweep(const BenchConfig& config)
+{
+    //every block jumps to the new cutoffs, through tan(), as before the glides
+    return runCrossoverSweep("legacyCrossoverSweep", config, 0.0);
+}
+
+static BenchResult benchLinearPhaseCrossover(const BenchConfig& config)
+{
+    LinearPhaseCrossover crossover;
+    crossover.setNumBands(Params::NumBands);
+
+    auto cutoffs = getDefaultCutoffs();
+    for (size_t i = 0; i < cutoffs.size(); ++i)
+    {
+        crossover.setCrossoverFrequency(static_cast<int>(i), cutoffs[i]);
+    }
+
+    crossover.prepare(makeSpec(config));
+
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+
+    std::vector<juce::AudioBuffer<float>> bands(Params::NumBands);
+    std::vector<juce::dsp::AudioBlock<float>> blocks;
+    for (auto& band : bands)
+    {
+        band.setSize(config.numChannels, config.blockSize);
+        blocks.emplace_back(band);
+    }
+
+    auto inputBlock = juce::dsp::AudioBlock<const float>(buffer);
+
+    BenchResult result{ "linearPhaseCrossover", config, getNumIterations(config) };
+
+    //the bands have to add back up to the input, delayed by the reported latency
+    {
+        auto latency = crossover.getLatencySamples();
+        std::vector<float> input;
+        juce::Random random(0x4d42);
+        auto maxError = 0.f;
+
+        for (int i = 0; i < result.iterations; ++i)
+        {
+            for (int n = 0; n < config.blockSize; ++n)
+            {
+                auto sample = random.nextFloat() - 0.5f;
+                input.push_back(sample);
+                for (int c = 0; c < config.numChannels; ++c)
+                {
+                    buffer.setSample(c, n, sample);
+                }
+            }
+
+            crossover.process(inputBlock, blocks.data());
+
+            for (int n = 0; n < config.blockSize; ++n)
+            {
+                auto position = i * config.blockSize + n - latency;
+                auto expected = position >= 0 ? input[static_cast<size_t>(position)] : 0.f;
+
+                for (int c = 0; c < config.numChannels; ++c)
+                {
+                    auto sum = 0.f;
+                    for (const auto& band : bands)
+                    {
+                        sum += band.getSample(c, n);
+                    }
+                    maxError = juce::jmax(maxError, std::abs(sum - expected));
+                }
+            }
+        }
+
+        result.maxAbsError = maxError;
+    }
+
+    fillWithNoise(buffer);
+    result.seconds = timeIterations(result.iterations, [&] { crossover.process(inputBlock, blocks.data()); });
+    return result;
+}
+
+static BenchResult benchLegacySplitCopies(const BenchConfig& config)
+{
+    //the copies splitBands() used to make before filtering: the input into all
+    //three band buffers, then band 1 into band 2 halfway down the crossover tree.
+    //splitBands() now writes each filter output straight into its band instead.
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    fillWithNoise(buffer);
+
+    std::array<juce::AudioBuffer<float>, 3> filterBuffers;
+    for (auto& filterBuffer : filterBuffers)
+    {
+        filterBuffer.setSize(config.numChannels, config.blockSize);
+    }
+
+    BenchResult result{ "legacySplitCopies", config, getNumIterations(config) };
+    result.copyBytesPerBlock = 4.0 * config.numChannels * config.blockSize * sizeof(float);
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        for (auto& filterBuffer : filterBuffers)
+        {
+            filterBuffer = buffer;
+        }
+        filterBuffers[2] = filterBuffers[1];
+    });
+    return result;
+}
+
+//settings low enough that noise keeps every band above threshold, so the gain computer always runs
+struct CompressorSettings
+{
+    float attackMs = 50.f;
+    float releaseMs = 250.f;
+    float thresholdDb = -18.f;
+    float ratio = 3.f;
+};
+
+template <typename SampleType>
+static void prepareEngine(MultiBandCompressor<SampleType>& engine, const BenchConfig& config, int numBands)
+{
+    CompressorSettings settings;
+    engine.prepare(makeSpec(config), numBands);
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        engine.setAttack(band, settings.attackMs);
+        engine.setRelease(band, settings.releaseMs);
+        engine.setThreshold(band, settings.thresholdDb);
+        engine.setRatio(band, settings.ratio);
+    }
+}
+
+//what CompressorBand used to run: one juce::dsp::Compressor per band
+static void prepareReferenceCompressors(std::array<juce::dsp::Compressor<float>, 3>& compressors, const BenchConfig& config)
+{
+    CompressorSettings settings;
+
+    for (auto& compressor : compressors)
+    {
+        compressor.prepare(makeSpec(config));
+        compressor.setAttack(settings.attackMs);
+        compressor.setRelease(settings.releaseMs);
+        compressor.setThreshold(settings.thresholdDb);
+        compressor.setRatio(settings.ratio);
+    }
+}
+
+static BenchResult benchMultiBandCompressor(const BenchConfig& config)
+{
+    MultiBandCompressor<float> engine;
+    prepareEngine(engine, config, 3);
+
+    std::array<juce::AudioBuffer<float>, 3> bands;
+    std::array<juce::dsp::AudioBlock<float>, 3> blocks;
+    for (size_t i = 0; i < bands.size(); ++i)
+    {
+        bands[i].setSize(config.numChannels, config.blockSize);
+        blocks[i] = juce::dsp::AudioBlock<float>(bands[i]);
+    }
+
+    BenchResult result{ "multiBandCompressor", config, getNumIterations(config) };
+
+    //check against three juce::dsp::Compressors fed the same fresh noise every block
+    {
+        std::array<juce::dsp::Compressor<float>, 3> reference;
+        prepareReferenceCompressors(reference, config);
+
+        auto expected = bands;
+        auto maxError = 0.f;
+
+        for (int i = 0; i < result.iterations; ++i)
+        {
+            for (size_t b = 0; b < bands.size(); ++b)
+            {
+                fillWithNoise(bands[b]);
+                bands[b].applyGain(static_cast<float>(b + 1) * 0.5f);
+                expected[b].makeCopyOf(bands[b], true);
+
+                auto block = juce::dsp::AudioBlock<float>(expected[b]);
+                reference[b].process(juce::dsp::ProcessContextReplacing<float>(block));
+            }
+
+            engine.process(blocks.data(), 0b111);
+
+            for (size_t b = 0; b < bands.size(); ++b)
+            {
+                for (int c = 0; c < config.numChannels; ++c)
+                {
+                    for (int n = 0; n < config.blockSize; ++n)
+                    {
+                        maxError = juce::jmax(maxError, std::abs(bands[b].getSample(c, n) - expected[b].getSample(c, n)));
+                    }
+                }
+            }
+        }
+
+        result.maxAbsError = maxError;
+    }
+
+    //compressing in place would take the noise below threshold after a few blocks, and then the
+    //gain computer never runs. every block starts from the same noise, as benchProcessBlock does
+    auto noise = bands;
+    for (size_t b = 0; b < noise.size(); ++b)
+    {
+        fillWithNoise(noise[b]);
+        noise[b].applyGain(static_cast<float>(b + 1) * 0.5f);
+    }
+
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        for (size_t b = 0; b < bands.size(); ++b)
+        {
+            bands[b].makeCopyOf(noise[b], true);
+        }
+
+        engine.process(blocks.data(), 0b111);
+    });
+    return result;
+}
+
+static BenchResult benchMultiBandCompressorDouble(const BenchConfig& config)
+{
+    //the same engine and load as multiBandCompressor, in double: half as many lanes per register
+    MultiBandCompressor<double> engine;
+    prepareEngine(engine, config, 3);
+
+    std::array<juce::AudioBuffer<double>, 3> bands, noise;
+    std::array<juce::dsp::AudioBlock<double>, 3> blocks;
+    juce::AudioBuffer<float> floatNoise(config.numChannels, config.blockSize);
+
+    for (size_t i = 0; i < bands.size(); ++i)
+    {
+        fillWithNoise(floatNoise);
+        floatNoise.applyGain(static_cast<float>(i + 1) * 0.5f);
+        noise[i].makeCopyOf(floatNoise);
+        bands[i].makeCopyOf(noise[i]);
+        blocks[i] = juce::dsp::AudioBlock<double>(bands[i]);
+    }
+
+    BenchResult result{ "multiBandCompressorDouble", config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        for (size_t i = 0; i < bands.size(); ++i)
+        {
+            bands[i].makeCopyOf(noise[i], true);
+        }
+
+        engine.process(blocks.data(), 0b111);
+    });
+    return result;
+}
+
+static BenchResult benchReferenceCompressors(const BenchConfig& config)
+{
+    std::array<juce::dsp::Compressor<float>, 3> compressors;
+    prepareReferenceCompressors(compressors, config);
+
+    //the same load as multiBandCompressor, restored before every block
+    std::array<juce::AudioBuffer<float>, 3> bands, noise;
+    std::array<juce::dsp::AudioBlock<float>, 3> blocks;
+    for (size_t i = 0; i < bands.size(); ++i)
+    {
+        noise[i].setSize(config.numChannels, config.blockSize);
+        fillWithNoise(noise[i]);
+        noise[i].applyGain(static_cast<float>(i + 1) * 0.5f);
+        bands[i].makeCopyOf(noise[i]);
+        blocks[i] = juce::dsp::AudioBlock<float>(bands[i]);
+    }
+
+    BenchResult result{ "referenceCompressors", config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        for (size_t i = 0; i < compressors.size(); ++i)
+        {
+            bands[i].makeCopyOf(noise[i], true);
+            compressors[i].process(juce::dsp::ProcessContextReplacing<float>(blocks[i]));
+        }
+    });
+    return result;
+}
+
+static BenchResult benchLegacyMetering(const BenchConfig& config)
+{
+    //the meter passes CompressorBand used to make around the dynamics: every channel's
+    //RMS before and after compression, each followed by a gainToDecibels. multiBandCompressor
+    //now gathers the same levels in the loop that applies the gain
+    std::array<juce::AudioBuffer<float>, 3> bands;
+    for (auto& band : bands)
+    {
+        band.setSize(config.numChannels, config.blockSize);
+        fillWithNoise(band);
+    }
+
+    auto getLevel = [](const juce::AudioBuffer<float>& buffer)
+    {
+        auto rms = 0.f;
+        for (int c = 0; c < buffer.getNumChannels(); ++c)
+        {
+            rms += buffer.getRMSLevel(c, 0, buffer.getNumSamples());
+        }
+        return juce::Decibels::gainToDecibels(rms / static_cast<float>(buffer.getNumChannels()));
+    };
+
+    //volatile, so the passes can't be optimised away
+    volatile float level = 0.f;
+
+    BenchResult result{ "legacyMetering", config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        for (const auto& band : bands)
+        {
+            level = getLevel(band);
+            level = getLevel(band);
+        }
+    });
+
+    return result;
+}
+
+static BenchResult benchLoudnessMeter(const BenchConfig& config)
+{
+    //K-weighting, 4x true peak and the gating, on the output of every block
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    fillWithNoise(buffer);
+
+    LoudnessMeter meter;
+    meter.prepare(config.sampleRate, config.numChannels);
+    meter.setChannelWeights(MBCompAudioProcessor::getLoudnessWeights(getChannelSetFor(config.numChannels)));
+
+    auto block = juce::dsp::AudioBlock<const float>(buffer);
+
+    BenchResult result{ "loudnessMeter", config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&] { meter.process(block); });
+    return result;
+}
+
+static BenchResult benchUpdateState(const BenchConfig& config)
+{
+    //no parameter moves between blocks, which is the common case without automation
+    auto processor = makeProcessor(config);
+
+    BenchResult result{ "updateState", config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&] { processor->updateState(); });
+    return result;
+}
+
+static BenchResult benchLegacyUpdateState(const BenchConfig& config)
+{
+    //what updateState() did before ParameterSnapshot: every setting pushed on every
+    //block, every crossover's coefficients recomputed and each ratio parsed from its choice name
+    auto processor = makeProcessor(config);
+    auto spec = makeSpec(config);
+
+    using namespace Params;
+
+    MultiBandCompressor<float> engine;
+    engine.prepare(spec, NumBands);
+
+    //without smoothing every set recomputes the coefficients, as it used to
+    LinkwitzRileyCrossover<float> crossover;
+    crossover.setNumBands(NumBands);
+    crossover.setSmoothing(0.0, LinkwitzRileyCrossover<float>::defaultControlInterval);
+    crossover.prepare(spec);
+
+    juce::dsp::Gain<float> inputGain, outputGain;
+    inputGain.prepare(spec);
+    outputGain.prepare(spec);
+
+    const auto& params = GetParams();
+    auto& apvts = processor->apvts;
+
+    auto getFloat = [&](Names name) { return dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(params.at(name))); };
+    auto getChoice = [&](Names name) { return dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(name))); };
+
+    //the processor held these pointers in CompressorBand, so look them up outside the timed loop
+    struct BandParams
+    {
+        juce::AudioParameterFloat* attack;
+        juce::AudioParameterFloat* release;
+        juce::AudioParameterFloat* threshold;
+        juce::AudioParameterChoice* ratio;
+    };
+
+    std::array<BandParams, NumBands> bands;
+    for (int band = 0; band < NumBands; ++band)
+    {
+        bands[static_cast<size_t>(band)] = { getFloat(getBandParam(Names::Attack, band)),
+                                             getFloat(getBandParam(Names::Release, band)),
+                                             getFloat(getBandParam(Names::Threshold, band)),
+                                             getChoice(getBandParam(Names::Ratio, band)) };
+    }
+
+    std::array<juce::AudioParameterFloat*, NumCrossovers> crossovers;
+    for (int i = 0; i < NumCrossovers; ++i)
+    {
+        crossovers[static_cast<size_t>(i)] = getFloat(getCrossoverParam(i));
+    }
+
+    auto* inGain = getFloat(Names::GainIn);
+    auto* outGain = getFloat(Names::GainOut);
+
+    BenchResult result{ "legacyUpdateState", config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        for (int band = 0; band < NumBands; ++band)
+        {
+            const auto& p = bands[static_cast<size_t>(band)];
+            engine.setAttack(band, p.attack->get());
+            engine.setRelease(band, p.release->get());
+            engine.setThreshold(band, p.threshold->get());
+            engine.setRatio(band, p.ratio->getCurrentChoiceName().getFloatValue());
+        }
+
+        for (int i = 0; i < NumCrossovers; ++i)
+        {
+            crossover.setCrossoverFrequency(i, crossovers[static_cast<size_t>(i)]->get());
+        }
+
+        inputGain.setGainDecibels(inGain->get());
+        outputGain.setGainDecibels(outGain->get());
+    });
+    return result;
+}
+
+static BenchResult benchCaptureUpdate(const BenchConfig& config)
+{
+    //both analyzer channels in one pass. the writer never waits for a reader, so nothing has to drain it
+    AnalyzerCaptureRing capture;
+    capture.prepare(config.blockSize);
+
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    fillWithNoise(buffer);
+
+    BenchResult result{ "captureUpdate", config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&] { capture.update(buffer); });
+    return result;
+}
+
+static BenchResult benchLegacyFifoUpdate(const BenchConfig& config)
+{
+    //what the processor did before the capture ring: a SingleChannelSampleFifo per analyzer channel,
+    //each walking the block on its own
+    SingleChannelSampleFifo<juce::AudioBuffer<float>> fifo{ Channel::Left };
+    SingleChannelSampleFifo<juce::AudioBuffer<float>> otherFifo{ Channel::Right };
+    fifo.prepare(config.blockSize);
+    otherFifo.prepare(config.blockSize);
+
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    fillWithNoise(buffer);
+    juce::AudioBuffer<float> drained;
+
+    //the fifo holds 32 buffers, so drain it (untimed) before it fills up
+    constexpr int batch = 16;
+    BenchResult result{ "legacyFifoUpdate", config, 0 };
+    auto iterations = getNumIterations(config);
+
+    while (result.iterations < iterations)
+    {
+        result.seconds += timeIterations(batch, [&]
+        {
+            fifo.update(buffer);
+            otherFifo.update(buffer);
+        });
+        result.iterations += batch;
+
+        while (fifo.getNumCompleteBuffersAvailable() > 0)
+            fifo.getAudioBuffer(drained);
+
+        while (otherFifo.getNumCompleteBuffersAvailable() > 0)
+            otherFifo.getAudioBuffer(drained);
+    }
+
+    return result;
+}
+
+static BenchResult benchFFTData(const BenchConfig& config)
+{
+    //one FFT of the analyzer, which PathProducer runs at most once per display frame
+    FFTDataGenerator<std::vector<float>> generator;
+    generator.changeOrder(FFTOrder::order2048);
+
+    juce::AudioBuffer<float> monoBuffer(1, generator.getFFTSize());
+    fillWithNoise(monoBuffer);
+    std::vector<float> drained;
+
+    constexpr int batch = 16;
+    BenchResult result{ "fftData", config, 0 };
+    auto iterations = juce::jmin(getNumIterations(config), 4096);
+
+    while (result.iterations < iterations)
+    {
+        result.seconds += timeIterations(batch, [&] { generator.produceFFTDataForRendering(monoBuffer, NEGINF); });
+        result.iterations += batch;
+
+        while (generator.getNumAvailableFFTDataBlocks() > 0)
+            generator.getFFTData(drained);
+    }
+
+    return result;
+}
+
+static BenchResult benchAnalyzer(const BenchConfig& config)
+{
+    //one analyzer channel as the audio and analysis threads run it: the capture every block, and
+    //PathProducer::process every 1/60 s of audio. the FFTs are capped at one a frame, so the share of
+    //the budget this uses shouldn't grow as the blocks get smaller
+    AnalyzerCaptureRing capture;
+    capture.prepare(config.blockSize);
+    PathProducer producer(capture, AnalyzerCaptureRing::View::left);
+
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    fillWithNoise(buffer);
+
+    const juce::Rectangle<float> fftBounds(0.f, 0.f, 600.f, 300.f);
+    const auto samplesPerFrame = config.sampleRate / 60.0;
+    auto samplesToNextFrame = samplesPerFrame;
+
+    BenchResult result{ "analyzer", config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        capture.update(buffer);
+
+        for (samplesToNextFrame -= config.blockSize; samplesToNextFrame <= 0.0; samplesToNextFrame += samplesPerFrame)
+        {
+            producer.process(fftBounds, config.sampleRate);
+        }
+    });
+    return result;
+}
+
+static void setParameter(MBCompAudioProcessor& processor, Params::Names name, float value)
+{
+    auto* parameter = processor.apvts.getParameter(Params::GetParams().at(name));
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+//times processBlock on the same noise every iteration, with the processor set up for the stage by 'setup'
+template <typename Setup>
+static BenchResult runProcessBlockStage(const juce::String& stage, const BenchConfig& config, Setup&& setup, int sidechainChannels = 0)
+{
+    auto processor = makeProcessor(config, sidechainChannels);
+    setup(*processor);
+
+    //main channels first, then the sidechain ones, the way a host lays them out
+    juce::AudioBuffer<float> buffer(config.numChannels + sidechainChannels, config.blockSize);
+    juce::MidiBuffer midi;
+
+    auto noise = buffer;
+    fillWithNoise(noise);
+
+    //nothing drains the analyzer fifos without an editor, which matches a closed plugin window
+    BenchResult result{ stage, config, getNumIterations(config) };
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        buffer.makeCopyOf(noise, true);
+        processor->processBlock(buffer, midi);
+    });
+    return result;
+}
+
+static BenchResult benchProcessBlock(const BenchConfig& config)
+{
+    return runProcessBlockStage("processBlock", config, [](MBCompAudioProcessor&) {});
+}
+
+static BenchResult benchProcessBlockSoloed(const BenchConfig& config)
+{
+    //one band soloed, so all the others are culled after the crossover
+    return runProcessBlockStage("processBlockSoloed", config, [](MBCompAudioProcessor& processor)
+    {
+        setParameter(processor, Params::getBandParam(Params::Names::Solo, Params::NumBands / 2), 1.f);
+    });
+}
+
+static BenchResult benchProcessBlockOversampled(const BenchConfig& config)
+{
+    //4x oversampling, which at the default crossovers only the top band pays for
+    return runProcessBlockStage("processBlockOversampled", config, [](MBCompAudioProcessor& processor)
+    {
+        setParameter(processor, Params::Names::Oversampling, 2.f);
+    });
+}
+
+static BenchResult benchProcessBlockLookahead(const BenchConfig& config)
+{
+    //the full 10 ms of lookahead. the sliding maximum costs the same at any length
+    return runProcessBlockStage("processBlockLookahead", config, [](MBCompAudioProcessor& processor)
+    {
+        setParameter(processor, Params::Names::Lookahead, static_cast<float>(MultiBandCompressor<float>::maxLookaheadMs));
+    });
+}
+
+static BenchResult benchProcessBlockSidechain(const BenchConfig& config)
+{
+    //every band keyed off a sidechain with the main bus's channel count (at most stereo), which adds the sidechain split
+    return runProcessBlockStage("processBlockSidechain", config, [](MBCompAudioProcessor& processor)
+    {
+        setParameter(processor, Params::Names::Sidechain, 1.f);
+    }, juce::jmin(config.numChannels, 2));
+}
+
+static BenchResult benchProcessBlockLinked(const BenchConfig& config)
+{
+    //every channel group sharing a detector, which adds one pass over each band to find the group levels
+    return runProcessBlockStage("processBlockLinked", config, [](MBCompAudioProcessor& processor)
+    {
+        setParameter(processor, Params::Names::ChannelLink, 1.f);
+    });
+}
+
+static BenchResult benchProcessBlockDouble(const BenchConfig& config)
+{
+    //the whole processBlock in double, as a 64-bit host runs it. maxAbsError is how far
+    //it lands from the float processBlock on the same input
+    auto processor = makeProcessor(config, 0, juce::AudioProcessor::doublePrecision);
+    juce::MidiBuffer midi;
+
+    juce::AudioBuffer<float> noise(config.numChannels, config.blockSize);
+    fillWithNoise(noise);
+
+    juce::AudioBuffer<double> buffer;
+    buffer.makeCopyOf(noise);
+
+    BenchResult result{ "processBlockDouble", config, getNumIterations(config) };
+
+    {
+        auto floatProcessor = makeProcessor(config);
+        auto floatBuffer = noise;
+        auto maxError = 0.0;
+
+        for (int i = 0; i < result.iterations; ++i)
+        {
+            floatBuffer.makeCopyOf(noise, true);
+            buffer.makeCopyOf(noise, true);
+
+            floatProcessor->processBlock(floatBuffer, midi);
+            processor->processBlock(buffer, midi);
+
+            for (int c = 0; c < config.numChannels; ++c)
+            {
+                for (int n = 0; n < config.blockSize; ++n)
+                {
+                    maxError = juce::jmax(maxError, std::abs(buffer.getSample(c, n) - static_cast<double>(floatBuffer.getSample(c, n))));
+                }
+            }
+        }
+
+        result.maxAbsError = maxError;
+    }
+
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        buffer.makeCopyOf(noise, true);
+        processor->processBlock(buffer, midi);
+    });
+    return result;
+}
+
+static BenchResult benchProcessBlockParallel(const BenchConfig& config)
+{
+    //a worker per band but one, or as many as there are spare cores. below
+    //parallelMinBlockSize this is the serial path plus one branch
+    auto numWorkers = juce::jmin(Params::NumBands - 1, juce::SystemStats::getNumPhysicalCpus() - 1);
+    auto processor = makeProcessor(config, 0, juce::AudioProcessor::singlePrecision, numWorkers);
+    auto serialProcessor = makeProcessor(config);
+
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    juce::MidiBuffer midi;
+
+    auto noise = buffer;
+    fillWithNoise(noise);
+
+    BenchResult result{ "processBlockParallel", config, getNumIterations(config) };
+    result.numWorkerThreads = processor->getNumWorkerThreads();
+
+    //every band runs the same code either way, so the two should agree exactly
+    {
+        auto serialBuffer = buffer;
+        auto maxError = 0.f;
+
+        for (int i = 0; i < result.iterations; ++i)
+        {
+            buffer.makeCopyOf(noise, true);
+            serialBuffer.makeCopyOf(noise, true);
+
+            processor->processBlock(buffer, midi);
+            serialProcessor->processBlock(serialBuffer, midi);
+
+            for (int c = 0; c < config.numChannels; ++c)
+            {
+                for (int n = 0; n < config.blockSize; ++n)
+                {
+                    maxError = juce::jmax(maxError, std::abs(buffer.getSample(c, n) - serialBuffer.getSample(c, n)));
+                }
+            }
+        }
+
+        result.maxAbsError = maxError;
+    }
+
+    auto serialSeconds = timeIterations(result.iterations, [&]
+    {
+        buffer.makeCopyOf(noise, true);
+        serialProcessor->processBlock(buffer, midi);
+    });
+
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        buffer.makeCopyOf(noise, true);
+        processor->processBlock(buffer, midi);
+    });
+
+    result.speedup = result.seconds > 0.0 ? serialSeconds / result.seconds : 0.0;
+    return result;
+}
+
+static BenchResult benchBands(const BenchConfig& config, int numBands)
+{
+    //the per band DSP (crossover and dynamics) at a band count chosen at runtime, so one
+    //build shows how the cost per band moves as bands are added. nsPerBandSample is the figure to compare
+    auto spec = makeSpec(config);
+
+    LinkwitzRileyCrossover<float> crossover;
+    crossover.setNumBands(numBands);
+
+    //set before prepare(), so the crossovers start there instead of gliding in from the default
+    for (int i = 0; i < numBands - 1; ++i)
+    {
+        crossover.setCrossoverFrequency(i, juce::mapToLog10(static_cast<float>(i + 1) / numBands, 50.f, 10000.f));
+    }
+
+    crossover.prepare(spec);
+
+    MultiBandCompressor<float> engine;
+    prepareEngine(engine, config, numBands);
+
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    fillWithNoise(buffer);
+
+    std::vector<juce::AudioBuffer<float>> bands(static_cast<size_t>(numBands));
+    std::vector<juce::dsp::AudioBlock<float>> blocks;
+    for (auto& band : bands)
+    {
+        band.setSize(config.numChannels, config.blockSize);
+        blocks.emplace_back(band);
+    }
+
+    auto inputBlock = juce::dsp::AudioBlock<const float>(buffer);
+    auto allBands = static_cast<juce::uint32>((1u << numBands) - 1);
+
+    BenchResult result{ "bands" + juce::String(numBands), config, getNumIterations(config) };
+    result.numBands = numBands;
+    result.seconds = timeIterations(result.iterations, [&]
+    {
+        crossover.process(inputBlock, blocks.data());
+        engine.process(blocks.data(), allBands);
+    });
+    return result;
+}
+
+//==============================================================================
+static int runBenchmarks(const juce::ArgumentList& args)
+{
+    if (args.containsOption("--seconds"))
+        audioSecondsPerCase = args.getValueForOption("--seconds").getDoubleValue();
+
+    auto stageFilter = args.getValueForOption("--stage");
+
+    using StageFn = std::function<BenchResult(const BenchConfig&)>;
+    std::vector<std::pair<juce::String, StageFn>> stages
+    {
+        { "splitBands", benchSplitBands },
+        { "legacySplitCopies", benchLegacySplitCopies },
+        { "referenceCrossover", benchReferenceCrossover },
+        { "linearPhaseCrossover", benchLinearPhaseCrossover },
+        { "crossoverSweep", benchCrossoverSweep },
+        { "legacyCrossoverSweep", benchLegacyCrossoverSweep },
+        { "multiBandCompressor", benchMultiBandCompressor },
+        { "multiBandCompressorDouble", benchMultiBandCompressorDouble },
+        { "referenceCompressors", benchReferenceCompressors },
+        { "legacyMetering", benchLegacyMetering },
+        { "loudnessMeter", benchLoudnessMeter },
+        { "updateState", benchUpdateState },
+        { "legacyUpdateState", benchLegacyUpdateState },
+        { "captureUpdate", benchCaptureUpdate },
+        { "legacyFifoUpdate", benchLegacyFifoUpdate },
+        { "fftData", benchFFTData },
+        { "analyzer", benchAnalyzer },
+        { "processBlock", benchProcessBlock },
+        { "processBlockSoloed", benchProcessBlockSoloed },
+        { "processBlockOversampled", benchProcessBlockOversampled },
+        { "processBlockLookahead", benchProcessBlockLookahead },
+        { "processBlockSidechain", benchProcessBlockSidechain },
+        { "processBlockLinked", benchProcessBlockLinked },
+        { "processBlockDouble", benchProcessBlockDouble },
+        { "processBlockParallel", benchProcessBlockParallel },
+    };
+
+    for (int numBands = 2; numBands <= MultiBandCompressor<float>::maxNumBands; ++numBands)
+    {
+        stages.push_back({ "bands" + juce::String(numBands), [numBands](const BenchConfig& config) { return benchBands(config, numBands); } });
+    }
+
+    //up to the 8192 sample blocks some hosts bounce with
+    const std::vector<int> blockSizes{ 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192 };
+    const std::vector<double> sampleRates{ 44100.0, 48000.0, 96000.0, 192000.0 };
+    //mono, stereo, 5.1 and 7.1.4
+    const std::vector<int> channelCounts{ 1, 2, 6, 12 };
+
+    juce::ScopedNoDenormals noDenormals;
+    juce::Array<juce::var> results;
+
+    for (const auto& [name, fn] : stages)
+    {
+        if (stageFilter.isNotEmpty() && stageFilter != name)
+            continue;
+
+        for (auto numChannels : channelCounts)
+        {
+            for (auto sampleRate : sampleRates)
+            {
+                for (auto blockSize : blockSizes)
+                {
+                    auto result = fn({ sampleRate, blockSize, numChannels });
+                    results.add(result.toVar());
+
+                    std::cout << name << " " << numChannels << "ch " << sampleRate << "Hz " << blockSize << ": "
+                              << result.getNsPerSample() << " ns/sample, " << result.getCpuPercent() << "% cpu" << std::endl;
+                }
+            }
+        }
+    }
+
+    auto* report = new juce::DynamicObject();
+    report->setProperty("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    report->setProperty("juceVersion", juce::SystemStats::getJUCEVersion());
+    report->setProperty("results", results);
+
+    auto json = juce::JSON::toString(juce::var(report));
+
+    if (args.containsOption("--output"))
+        args.getFileForOption("--output").replaceWithText(json);
+    else
+        std::cout << json << std::endl;
+
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&args] { return runBenchmarks(args); });
+}
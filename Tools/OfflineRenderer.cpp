@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 18 Oct 2026 10:02:41am
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+juce::var RenderStats::toVar() const
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("input", inputFile.getFullPathName());
+    obj->setProperty("output", outputFile.getFullPathName());
+    obj->setProperty("sampleRate", sampleRate);
+    obj->setProperty("numChannels", numChannels);
+    obj->setProperty("numSamples", numSamples);
+    obj->setProperty("audioSeconds", getAudioSeconds());
+    obj->setProperty("dspSeconds", dspSeconds);
+    obj->setProperty("wallSeconds", wallSeconds);
+    obj->setProperty("xRT", getRealTimeFactor());
+    obj->setProperty("wallxRT", getWallRealTimeFactor());
+    obj->setProperty("samplesPerSecond", getSamplesPerSecond());
+    obj->setProperty("integratedLUFS", loudness.integrated);
+    obj->setProperty("maxMomentaryLUFS", loudness.maxMomentary);
+    obj->setProperty("maxShortTermLUFS", loudness.maxShortTerm);
+    obj->setProperty("truePeakdBTP", loudness.truePeak);
+
+    return juce::var(obj);
+}
+
+OfflineRenderer::OfflineRenderer(const RenderSettings& s) : settings(s)
+{
+    formatManager.registerBasicFormats();
+}
+
+juce::Result OfflineRenderer::loadPreset()
+{
+    presetData.reset();
+
+    if (settings.presetFile == juce::File())
+        return juce::Result::ok();
+
+    if (!settings.presetFile.loadFileAsData(presetData))
+        return juce::Result::fail("Could not read preset " + settings.presetFile.getFullPathName());
+
+    return juce::Result::ok();
+}
+
+juce::File OfflineRenderer::getOutputFileFor(const juce::File& inputFile) const
+{
+    auto dir = settings.outputDirectory == juce::File() ? inputFile.getParentDirectory()
+                                                        : settings.outputDirectory;
+
+    return dir.getChildFile(inputFile.getFileNameWithoutExtension() + "_mbcomp" + inputFile.getFileExtension());
+}
+
+juce::Result OfflineRenderer::prepareProcessor(MBCompAudioProcessor& processor, int numChannels, double sampleRate)
+{
+    auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+
+    auto layout = processor.getBusesLayout();
+    layout.getChannelSet(true, 0) = channelSet;
+    layout.getChannelSet(false, 0) = channelSet;
+
+    if (!processor.setBusesLayout(layout))
+        return juce::Result::fail("Unsupported channel count: " + juce::String(numChannels));
+
+    if (presetData.getSize() > 0)
+        processor.setStateInformation(presetData.getData(), static_cast<int>(presetData.getSize()));
+
+    processor.setNonRealtime(true);
+    processor.setNumWorkerThreads(settings.numBandThreads);
+    processor.setRateAndBufferSizeDetails(sampleRate, settings.blockSize);
+    processor.prepareToPlay(sampleRate, settings.blockSize);
+
+    return juce::Result::ok();
+}
+
+juce::Result OfflineRenderer::renderFile(const juce::File& inputFile, RenderStats& stats)
+{
+    MBCompAudioProcessor processor;
+    return renderFile(inputFile, stats, processor, nullptr);
+}
+
+juce::Result OfflineRenderer::renderFile(const juce::File& inputFile, RenderStats& stats,
+                                         MBCompAudioProcessor& processor, juce::TimeSliceThread* ioThread)
+{
+    auto wallStart = juce::Time::getHighResolutionTicks();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(inputFile));
+    if (reader == nullptr)
+        return juce::Result::fail("Could not open " + inputFile.getFullPathName());
+
+    auto outputFile = getOutputFileFor(inputFile);
+    auto* format = formatManager.findFormatForFileExtension(outputFile.getFileExtension());
+    if (format == nullptr)
+        return juce::Result::fail("No writer for " + outputFile.getFileExtension());
+
+    const auto numChannels = static_cast<int>(reader->numChannels);
+    const auto sampleRate = reader->sampleRate;
+    const auto lengthInSamples = reader->lengthInSamples;
+    const auto bitsPerSample = static_cast<int>(reader->bitsPerSample);
+    const auto metadata = reader->metadataValues;
+
+    const auto ioBufferSize = juce::jmax(ioBufferSamples, settings.blockSize * 4);
+
+    if (ioThread != nullptr)
+    {
+        //the offline processor mustn't get silence for a block that wasn't decoded in time, so wait for it instead
+        auto* bufferingReader = new juce::BufferingAudioReader(reader.release(), *ioThread, ioBufferSize);
+        bufferingReader->setReadTimeout(-1);
+        reader.reset(bufferingReader);
+    }
+
+    auto result = prepareProcessor(processor, numChannels, sampleRate);
+    if (result.failed())
+        return result;
+
+    outputFile.deleteFile();
+    auto stream = outputFile.createOutputStream();
+    if (stream == nullptr)
+        return juce::Result::fail("Could not create " + outputFile.getFullPathName());
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+        sampleRate,
+        static_cast<unsigned int>(numChannels),
+        bitsPerSample,
+        metadata,
+        0));
+
+    if (writer == nullptr)
+        return juce::Result::fail("Could not create writer for " + outputFile.getFullPathName());
+
+    stream.release(); //the writer owns the stream now
+
+    //with an I/O thread, blocks are queued for it to encode and the processor moves straight on
+    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threadedWriter;
+    if (ioThread != nullptr)
+        threadedWriter = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(writer.release(), *ioThread, ioBufferSize);
+
+    std::vector<const float*> channelPointers(static_cast<size_t>(numChannels));
+
+    auto write = [&](const juce::AudioBuffer<float>& block, int start, int numToWrite)
+    {
+        if (threadedWriter == nullptr)
+        {
+            writer->writeFromAudioSampleBuffer(block, start, numToWrite);
+            return;
+        }
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            channelPointers[static_cast<size_t>(c)] = block.getReadPointer(c, start);
+        }
+
+        //only fails while the queue is full, so give the encoder a moment to catch up
+        while (!threadedWriter->write(channelPointers.data(), numToWrite))
+            juce::Thread::sleep(1);
+    };
+
+    //the processor may report latency, so run that many extra samples
+    //through it and drop the same amount from the start of the output.
+    const auto latency = static_cast<juce::int64>(processor.getLatencySamples());
+    const auto totalSamples = lengthInSamples + latency;
+
+    juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+    juce::MidiBuffer midi;
+
+    auto dspTicks = static_cast<juce::int64>(0);
+
+    for (juce::int64 pos = 0; pos < totalSamples; pos += settings.blockSize)
+    {
+        auto numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(settings.blockSize), totalSamples - pos));
+
+        buffer.clear();
+        if (pos < lengthInSamples)
+        {
+            auto numToRead = static_cast<int>(juce::jmin(static_cast<juce::int64>(numSamples), lengthInSamples - pos));
+            reader->read(&buffer, 0, numToRead, pos, true, true);
+        }
+
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+        auto start = juce::Time::getHighResolutionTicks();
+        processor.processBlock(block, midi);
+        dspTicks += juce::Time::getHighResolutionTicks() - start;
+
+        auto skip = static_cast<int>(juce::jlimit(static_cast<juce::int64>(0), static_cast<juce::int64>(numSamples), latency - pos));
+        if (numSamples - skip > 0)
+            write(block, skip, numSamples - skip);
+    }
+
+    //flushes whatever the I/O thread hasn't encoded yet
+    threadedWriter.reset();
+    writer.reset();
+
+    //the last 100 ms step is usually cut short, and its true peak still counts
+    processor.loudnessMeter.finish();
+    stats.loudness = processor.loudnessMeter.getReadings();
+    processor.releaseResources();
+
+    stats.inputFile = inputFile;
+    stats.outputFile = outputFile;
+    stats.sampleRate = sampleRate;
+    stats.numChannels = numChannels;
+    stats.numSamples = lengthInSamples;
+    stats.dspSeconds = juce::Time::highResolutionTicksToSeconds(dspTicks);
+    stats.wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - wallStart);
+
+    return juce::Result::ok();
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 18 Oct 2026 10:02:41am
+    Author:  Aidan
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+struct RenderSettings
+{
+    int blockSize = 512;
+    //worker threads per processor for the bands of long blocks, see MBCompAudioProcessor::setNumWorkerThreads()
+    int numBandThreads = 0;
+    juce::File presetFile;
+    juce::File outputDirectory;
+};
+
+struct RenderStats
+{
+    juce::File inputFile;
+    juce::File outputFile;
+
+    double sampleRate = 0.0;
+    int numChannels = 0;
+    juce::int64 numSamples = 0;
+
+    double dspSeconds = 0.0;     //time spent inside processBlock
+    double wallSeconds = 0.0;    //decode + processBlock + encode
+
+    //of the rendered output, latency included
+    LoudnessMeter::Readings loudness;
+
+    double getAudioSeconds() const { return sampleRate > 0.0 ? numSamples / sampleRate : 0.0; }
+    double getRealTimeFactor() const { return dspSeconds > 0.0 ? getAudioSeconds() / dspSeconds : 0.0; }
+    double getWallRealTimeFactor() const { return wallSeconds > 0.0 ? getAudioSeconds() / wallSeconds : 0.0; }
+    double getSamplesPerSecond() const { return dspSeconds > 0.0 ? numSamples * numChannels / dspSeconds : 0.0; }
+
+    juce::var toVar() const;
+};
+
+/*
+ Drives MBCompAudioProcessor without ever creating its editor.
+ Each file is decoded, pushed through processBlock() in blocks of
+ RenderSettings::blockSize samples and written next to the input
+ (or into RenderSettings::outputDirectory) with a "_mbcomp" suffix.
+
+ Once the preset is loaded, renderFile() can be called from several
+ threads at once, as long as each brings its own processor.
+ */
+struct OfflineRenderer
+{
+    //samples decoded ahead of and encoded behind the processor, when that runs on an I/O thread
+    static constexpr int ioBufferSamples = 1 << 16;
+
+    OfflineRenderer(const RenderSettings& settings);
+
+    juce::Result loadPreset();
+
+    juce::Result renderFile(const juce::File& inputFile, RenderStats& stats);
+
+    /*
+     renders with a processor that's reused from file to file. if 'ioThread' isn't
+     null (and is running), decoding and encoding happen on it, overlapping processBlock()
+     */
+    juce::Result renderFile(const juce::File& inputFile, RenderStats& stats,
+                            MBCompAudioProcessor& processor, juce::TimeSliceThread* ioThread);
+
+    juce::File getOutputFileFor(const juce::File& inputFile) const;
+private:
+    RenderSettings settings;
+    juce::AudioFormatManager formatManager;
+    juce::MemoryBlock presetData;
+
+    juce::Result prepareProcessor(MBCompAudioProcessor& processor, int numChannels, double sampleRate);
+};
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    RenderMain.cpp
+    Created: 18 Oct 2026 10:14:05am
+    Author:  Aidan
+
+    Command line entry point for the headless renderer. Build it as a JUCE
+    console application that compiles the same sources and module set as
+    the plugin (the editor is linked but never created).
+
+    MBCompRender [--block-size=512] [--band-threads=0] [--jobs=1] [--preset=state.bin]
+                 [--output-dir=dir] [--report=report.json] file1.wav [file2.aiff ...]
+
+    --jobs renders that many files at once (0 is one per CPU), see BatchRenderer.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "OfflineRenderer.h"
+#include "BatchRenderer.h"
+
+static void printStats(const RenderStats& stats)
+{
+    std::cout << stats.inputFile.getFileName() << " -> " << stats.outputFile.getFileName() << "\n"
+              << "    " << stats.numChannels << " ch @ " << stats.sampleRate << " Hz, "
+              << stats.getAudioSeconds() << " s of audio\n"
+              << "    dsp:  " << stats.dspSeconds << " s (" << stats.getRealTimeFactor() << " xRT, "
+              << stats.getSamplesPerSecond() / 1.0e6 << " Msamples/s)\n"
+              << "    wall: " << stats.wallSeconds << " s (" << stats.getWallRealTimeFactor() << " xRT)\n"
+              << "    loudness: " << stats.loudness.integrated << " LUFS integrated, "
+              << stats.loudness.maxShortTerm << " LUFS max short-term, "
+              << stats.loudness.truePeak << " dBTP\n";
+}
+
+static int runRender(const juce::ArgumentList& args)
+{
+    RenderSettings settings;
+
+    if (args.containsOption("--block-size"))
+        settings.blockSize = args.getValueForOption("--block-size").getIntValue();
+
+    if (settings.blockSize <= 0)
+        juce::ConsoleApplication::fail("--block-size must be positive");
+
+    if (args.containsOption("--band-threads"))
+        settings.numBandThreads = args.getValueForOption("--band-threads").getIntValue();
+
+    if (settings.numBandThreads < 0)
+        juce::ConsoleApplication::fail("--band-threads can't be negative");
+
+    auto numJobs = 1;
+    if (args.containsOption("--jobs"))
+        numJobs = args.getValueForOption("--jobs").getIntValue();
+
+    if (numJobs < 0)
+        juce::ConsoleApplication::fail("--jobs can't be negative");
+
+    if (args.containsOption("--preset"))
+        settings.presetFile = args.getExistingFileForOption("--preset");
+
+    if (args.containsOption("--output-dir"))
+    {
+        settings.outputDirectory = args.getFileForOption("--output-dir");
+        settings.outputDirectory.createDirectory();
+    }
+
+    juce::Array<juce::File> inputFiles;
+    for (const auto& arg : args.arguments)
+    {
+        if (!arg.isOption())
+            inputFiles.add(arg.resolveAsExistingFile());
+    }
+
+    if (inputFiles.isEmpty())
+        juce::ConsoleApplication::fail("No input files");
+
+    OfflineRenderer renderer(settings);
+
+    if (auto result = renderer.loadPreset(); result.failed())
+        juce::ConsoleApplication::fail(result.getErrorMessage());
+
+    std::vector<RenderStats> rendered;
+    auto numFailed = 0;
+    juce::var batchReport;
+
+    auto renderStart = juce::Time::getHighResolutionTicks();
+
+    if (numJobs == 1)
+    {
+        for (const auto& file : inputFiles)
+        {
+            RenderStats stats;
+            auto result = renderer.renderFile(file, stats);
+
+            if (result.failed())
+            {
+                std::cerr << result.getErrorMessage() << std::endl;
+                ++numFailed;
+                continue;
+            }
+
+            rendered.push_back(stats);
+        }
+    }
+    else
+    {
+        BatchRenderer batch(renderer, numJobs);
+        auto batchStats = batch.render(inputFiles);
+
+        for (const auto& error : batchStats.errors)
+        {
+            std::cerr << error << std::endl;
+        }
+
+        numFailed = batchStats.errors.size();
+        rendered = batchStats.files;
+        batchReport = batchStats.toVar();
+
+        for (size_t i = 0; i < batchStats.workers.size(); ++i)
+        {
+            const auto& worker = batchStats.workers[i];
+            auto utilisation = batchStats.wallSeconds > 0.0 ? worker.activeSeconds / batchStats.wallSeconds * 100.0 : 0.0;
+            auto dspUtilisation = batchStats.wallSeconds > 0.0 ? worker.dspSeconds / batchStats.wallSeconds * 100.0 : 0.0;
+
+            std::cout << "worker " << i << ": " << worker.filesRendered << " file(s), " << worker.filesStolen << " stolen, "
+                      << utilisation << "% busy, " << dspUtilisation << "% in dsp\n";
+        }
+    }
+
+    //with --jobs the files overlap, so throughput comes from the time the whole run took
+    auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - renderStart);
+
+    juce::Array<juce::var> fileReports;
+    auto audioSeconds = 0.0, dspSeconds = 0.0, wallSeconds = 0.0;
+    auto channelSamples = 0.0;
+
+    for (const auto& stats : rendered)
+    {
+        printStats(stats);
+        fileReports.add(stats.toVar());
+
+        audioSeconds += stats.getAudioSeconds();
+        dspSeconds += stats.dspSeconds;
+        wallSeconds += stats.wallSeconds;
+        channelSamples += static_cast<double>(stats.numSamples) * stats.numChannels;
+    }
+
+    auto xRT = dspSeconds > 0.0 ? audioSeconds / dspSeconds : 0.0;
+    auto wallxRT = wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0;
+
+    std::cout << "\n" << fileReports.size() << " file(s), block size " << settings.blockSize << ": "
+              << audioSeconds << " s of audio in " << dspSeconds << " s dsp (" << xRT << " xRT), "
+              << wallSeconds << " s wall (" << wallxRT << " xRT)" << std::endl;
+
+    auto filesPerSecond = elapsedSeconds > 0.0 ? rendered.size() / elapsedSeconds : 0.0;
+    auto samplesPerSecond = elapsedSeconds > 0.0 ? channelSamples / elapsedSeconds : 0.0;
+
+    std::cout << "throughput: " << filesPerSecond << " files/s, " << samplesPerSecond / 1.0e6 << " Msamples/s over "
+              << elapsedSeconds << " s" << std::endl;
+
+    if (args.containsOption("--report"))
+    {
+        auto* report = new juce::DynamicObject();
+        report->setProperty("blockSize", settings.blockSize);
+        report->setProperty("bandThreads", settings.numBandThreads);
+        report->setProperty("jobs", numJobs);
+        report->setProperty("files", fileReports);
+        report->setProperty("audioSeconds", audioSeconds);
+        report->setProperty("dspSeconds", dspSeconds);
+        report->setProperty("wallSeconds", wallSeconds);
+        report->setProperty("xRT", xRT);
+        report->setProperty("wallxRT", wallxRT);
+        report->setProperty("elapsedSeconds", elapsedSeconds);
+        report->setProperty("filesPerSecond", filesPerSecond);
+        report->setProperty("samplesPerSecond", samplesPerSecond);
+
+        if (!batchReport.isVoid())
+            report->setProperty("batch", batchReport);
+
+        args.getFileForOption("--report").replaceWithText(juce::JSON::toString(juce::var(report)));
+    }
+
+    return numFailed == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+    //APVTS needs a message manager for its timer, but nothing here touches a display
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&args] { return runRender(args); });
+}